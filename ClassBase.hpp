@@ -5,7 +5,9 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <random>
+#include <bit>
 #include <chrono>
 #include <limits>
 #include <numeric>
@@ -16,15 +18,25 @@
 #include <algorithm>
 #include <array>
 #include <ranges>
+#include <atomic>
+#include <cmath>
+#include <new>
+#include <span>
+#include <filesystem>
 
 #ifdef _WIN32
 #include <Windows.h>
+#include <intrin.h>
 #else
 #include <clocale>
 #include <sys/ioctl.h>
 #include <unistd.h>
 #endif
 
+#include "MappedFile.hpp"
+#include "NodePool.hpp"
+#include "OpenHashMap.hpp"
+
 // 0th index bit count for unsigned long long
 constexpr std::size_t MAX_ULL_BITS = 64;
 
@@ -63,261 +75,1679 @@ public:
 	~HighResTimer() = default;
 
 	/**
-	* @brief Start the timer
-	*
-	* Records the current time as the starting point
-	* and initializes the stop time to the same value
+	* @brief Start the timer
+	*
+	* Records the current time as the starting point
+	* and initializes the stop time to the same value
+	*/
+	void Start()
+	{
+		start = Timer::type::now();
+		stop = start;
+	}
+
+	/**
+	* @brief Stop the timer
+	*
+	* Records the current time as the stopping point
+	*/
+	void Stop()
+	{
+		stop = Timer::type::now();
+	}
+
+	/**
+	* @brief Get the elapsed time
+	*
+	* Calculates the time difference between start and stop points
+	*
+	* @return The elapsed time in microseconds
+	*/
+	double GetElapsed() const
+	{
+		return Microseconds( stop - start ).count();
+	}
+
+	/**
+	* @brief prints start and stop times to console.
+	*/
+	void PrintTimes() const
+	{
+		std::println( "Start Time: {}, Stop Time: {}.",start.time_since_epoch().count(), stop.time_since_epoch().count() );
+	}
+};
+
+
+/**
+* @brief Compiler sink used by DoNotOptimize on MSVC,
+* since it has no inline asm for x64
+*/
+inline const volatile void* benchmarkSink = nullptr;
+
+/**
+* @brief Stops the compiler from throwing away the
+* work that produced a value
+*
+* The value is treated as if it is read by something
+* the optimizer can't see, so the code computing it has to stay
+*
+* @param value The value we want to keep alive
+*/
+template< typename V >
+inline void DoNotOptimize( const V& value )
+{
+#if defined( _MSC_VER ) && !defined( __clang__ )
+	benchmarkSink = std::addressof( value );
+	std::atomic_signal_fence( std::memory_order_seq_cst );
+#else
+	asm volatile( "" : : "r,m"( value ) : "memory" );
+#endif
+}
+
+/**
+* @brief Forces all pending memory writes to be
+* treated as observed, so stores into our arrays
+* can't be removed or moved outside the timed region
+*/
+inline void ClobberMemory()
+{
+#if defined( _MSC_VER ) && !defined( __clang__ )
+	std::atomic_signal_fence( std::memory_order_seq_cst );
+#else
+	asm volatile( "" : : : "memory" );
+#endif
+}
+
+/**
+* @brief Hints the cache line holding address into L1, the
+* address does not have to be valid
+*
+* @param address Address we are about to read
+*/
+inline void Prefetch( const void* address )
+{
+#if defined( _MSC_VER ) && !defined( __clang__ )
+	_mm_prefetch( static_cast< const char* >( address ), _MM_HINT_T0 );
+#else
+	__builtin_prefetch( address );
+#endif
+}
+
+/**
+* @brief Allocator that starts every allocation on an Alignment
+* byte boundary, for containers laid out around cache lines
+*
+* @tparam Alignment Alignment in bytes, a power of two
+*/
+template< typename T, std::size_t Alignment = 64 >
+struct AlignedAllocator
+{
+	using value_type = T;
+
+	template< typename U >
+	struct rebind
+	{
+		using other = AlignedAllocator< U, Alignment >;
+	};
+
+	AlignedAllocator() = default;
+
+	template< typename U >
+	AlignedAllocator( const AlignedAllocator< U, Alignment >& ) noexcept {}
+
+	T* allocate( const std::size_t count )
+	{
+		return static_cast< T* >( ::operator new( count * sizeof( T ), std::align_val_t( Alignment ) ) );
+	}
+
+	void deallocate( T* ptr, const std::size_t ) noexcept
+	{
+		::operator delete( ptr, std::align_val_t( Alignment ) );
+	}
+
+	template< typename U >
+	bool operator==( const AlignedAllocator< U, Alignment >& ) const noexcept
+	{
+		return true;
+	}
+};
+
+
+/**
+* @brief Summary statistics for a set of timed runs
+*
+* All times are in microseconds, throughput is
+* based on the median run
+*/
+struct BenchStats
+{
+	std::size_t samples = 0; //< Number of measured runs
+	std::size_t elements = 0; //< Elements processed per run
+	double minUs = 0.0; //< Fastest run
+	double medianUs = 0.0; //< Median run
+	double p99Us = 0.0; //< 99th percentile run
+	double meanUs = 0.0; //< Mean of all runs
+	double stddevUs = 0.0; //< Sample standard deviation
+	double elementsPerSec = 0.0; //< Elements per second at the median
+};
+
+
+/**
+* @brief Runs a piece of work many times and collects
+* statistics using our HighResTimer
+*
+* Each run is split into an untimed setup step, so we can
+* restore the input array, and the timed work step. Warmup runs
+* are done first to get caches, branch predictors and page tables
+* into a steady state, these are not recorded.
+*/
+class BenchmarkRunner
+{
+private:
+	std::size_t warmupRuns; //< Runs done before we start recording
+	std::size_t measuredRuns; //< Runs we record
+	HighResTimer timer; //< Timer for each run
+	std::vector<double> samples; //< Time of each measured run in us
+
+public:
+	/**
+	* @brief Constructor
+	*
+	* @param warmup Number of untimed warmup runs
+	* @param runs Number of timed runs, minimum of 1
+	*/
+	explicit BenchmarkRunner( const std::size_t warmup = 3, const std::size_t runs = 15 ):
+		warmupRuns( warmup ), measuredRuns( std::max< std::size_t >( runs, 1 ) ) {}
+
+	/**
+	* @brief Default destructor
+	*/
+	~BenchmarkRunner() = default;
+
+	/**
+	* @brief Runs setup then work for every warmup and measured run
+	*
+	* @param elements Number of elements work handles per run, used for throughput
+	* @param setup Called before every run, this is not timed
+	* @param work The code we are measuring
+	* @return Statistics for the measured runs
+	*/
+	template< typename Setup, typename Work >
+	BenchStats Run( const std::size_t elements, Setup&& setup, Work&& work )
+	{
+		samples.clear();
+		samples.reserve( measuredRuns );
+
+		for ( std::size_t i = 0; i < warmupRuns; ++i )
+		{
+			setup();
+			work();
+			ClobberMemory();
+		}
+
+		for ( std::size_t i = 0; i < measuredRuns; ++i )
+		{
+			setup();
+			ClobberMemory();
+
+			timer.Start();
+			work();
+			ClobberMemory();
+			timer.Stop();
+
+			samples.push_back( timer.GetElapsed() );
+		}
+
+		return ComputeStats( elements );
+	}
+
+	/**
+	* @brief Prints the statistics of a benchmark
+	*
+	* @param name Name of what was benchmarked
+	* @param stats The statistics to print
+	*/
+	static void PrintStats( const std::string& name, const BenchStats& stats )
+	{
+		std::println( "================================================================" );
+		std::println( "<{} Benchmark>", name );
+		std::println( "Runs: {}, Elements: {}", stats.samples, stats.elements );
+		std::println( "Min: {:.3f} us, Median: {:.3f} us, P99: {:.3f} us", stats.minUs, stats.medianUs, stats.p99Us );
+		std::println( "Mean: {:.3f} us, Std Dev: {:.3f} us", stats.meanUs, stats.stddevUs );
+		std::println( "Throughput: {:.0f} elements/s", stats.elementsPerSec );
+	}
+
+	/**
+	* @brief Prints the CSV header that matches PrintCsvRow
+	*
+	* @param out Stream to write to
+	*/
+	static void PrintCsvHeader( std::ostream& out )
+	{
+		std::println( out, "distribution,algorithm,size,min_us,median_us,p99_us,ns_per_element" );
+	}
+
+	/**
+	* @brief Prints the statistics of a benchmark as a CSV row
+	*
+	* @param out Stream to write to
+	* @param distribution Name of the input distribution
+	* @param name Name of what was benchmarked
+	* @param stats The statistics to print
+	*/
+	static void PrintCsvRow( std::ostream& out, const std::string_view distribution, const std::string_view name, const BenchStats& stats )
+	{
+		const double nsPerElement = stats.elements > 0 ? stats.medianUs * 1000.0 / stats.elements : 0.0;
+		std::println( out, "{},{},{},{:.3f},{:.3f},{:.3f},{:.3f}",
+			distribution, name, stats.elements, stats.minUs, stats.medianUs, stats.p99Us, nsPerElement );
+	}
+
+private:
+	/**
+	* @brief Builds the statistics from our samples
+	*
+	* Percentiles use the nearest rank method
+	*
+	* @param elements Number of elements handled per run
+	* @return Statistics for the recorded samples
+	*/
+	BenchStats ComputeStats( const std::size_t elements )
+	{
+		BenchStats stats;
+		stats.samples = samples.size();
+		stats.elements = elements;
+
+		std::ranges::sort( samples );
+
+		const auto Percentile = [ & ]( const double pct )
+		{
+			const auto rank = static_cast< std::size_t >( std::ceil( pct * samples.size() ) );
+			return samples[ std::clamp< std::size_t >( rank, 1, samples.size() ) - 1 ];
+		};
+
+		stats.minUs = samples.front();
+		stats.medianUs = Percentile( 0.50 );
+		stats.p99Us = Percentile( 0.99 );
+		stats.meanUs = std::accumulate( samples.begin(), samples.end(), 0.0 ) / samples.size();
+
+		/// Sample standard deviation
+		if ( samples.size() > 1 )
+		{
+			double sqDiff = 0.0;
+			for ( const double s : samples )
+			{
+				sqDiff += ( s - stats.meanUs ) * ( s - stats.meanUs );
+			}
+			stats.stddevUs = std::sqrt( sqDiff / ( samples.size() - 1 ) );
+		}
+
+		if ( stats.medianUs > 0.0 )
+		{
+			stats.elementsPerSec = elements / ( stats.medianUs * 1e-6 );
+		}
+		return stats;
+	}
+};
+
+
+/*
+* @brief Constraint for our algorithm base class
+* @tparam T this is required to be a integer or floating point
+* variable, or custom one that implements
+* std::numeric_limits::specialized characteristics properly
+*/
+template < typename T>
+concept NumericConstraint =
+std::numeric_limits<T>::is_specialized &&
+std::is_arithmetic_v<T>;
+
+
+/**
+* @brief Shapes of input data we can generate
+* for the sorting and searching algorithms
+*/
+enum class Distribution
+{
+	Uniform, //< Uniform random values
+	Sorted, //< Already in ascending order
+	Reverse, //< In descending order
+	NearlySorted, //< Ascending with 1% of elements swapped
+	FewUnique, //< Only 16 different values
+	Sawtooth, //< 16 ascending runs, each restarting at 0
+	OrganPipe, //< Ascending to the middle then descending
+	Zipf, //< Zipf distributed values, small values are very common
+	AllEqual, //< Every element is the same
+};
+
+/// Every distribution, in the order they are benchmarked
+inline constexpr std::array<Distribution, 9> allDistributions =
+{
+	Distribution::Uniform, Distribution::Sorted, Distribution::Reverse,
+	Distribution::NearlySorted, Distribution::FewUnique, Distribution::Sawtooth,
+	Distribution::OrganPipe, Distribution::Zipf, Distribution::AllEqual,
+};
+
+/**
+* @brief Gets the name of a distribution for printing
+*
+* @param dist The distribution
+* @return Name of the distribution
+*/
+constexpr std::string_view GetDistributionName( const Distribution dist )
+{
+	switch ( dist )
+	{
+		case Distribution::Uniform: return "Uniform";
+		case Distribution::Sorted: return "Sorted";
+		case Distribution::Reverse: return "Reverse";
+		case Distribution::NearlySorted: return "Nearly Sorted";
+		case Distribution::FewUnique: return "Few Unique";
+		case Distribution::Sawtooth: return "Sawtooth";
+		case Distribution::OrganPipe: return "Organ Pipe";
+		case Distribution::Zipf: return "Zipf";
+		case Distribution::AllEqual: return "All Equal";
+	}
+	return "Unknown";
+}
+
+
+/**
+* @brief Base class for searching and sorting algorithmns
+* It includes all the nessary functions needed for initializing
+* a vector of numerics with uniform randomness. This also includes
+* an xor based swap function, and the function needed to print the
+* array of data.
+* 
+* @tparam T Numeric type that meets the NumericConstraint requirement
+*/
+template <typename T>
+	requires NumericConstraint<T>
+class AlgorithmsBase
+{
+protected:
+	std::size_t szArray = 0; //< Size of array 
+	std::vector<T> array; //< Our array
+	std::span<T> view; //< What the algorithms run on, either array or a mapped file
+	std::vector<T> tempBuffer; //< Temp buffer for quick sort
+	HighResTimer timer = HighResTimer(); //< timer for timing algorithms
+	Distribution distribution = Distribution::Uniform; //< Shape of the data InitArray( size ) generates
+	MappedFile mappedFile; //< File LoadArray mapped, closed when the array is reset
+
+
+public:
+
+	/**
+	* @brief Sets the distribution used by InitArray( size )
+	*
+	* @param dist The distribution to generate
+	*/
+	void SetDistribution( const Distribution dist )
+	{
+		distribution = dist;
+	}
+
+	/**
+	* @brief Gets the distribution used by InitArray( size )
+	*
+	* @return The current distribution
+	*/
+	Distribution GetDistribution() const
+	{
+		return distribution;
+	}
+
+
+	/**
+	* @brief Initialize array with random size and elements
+	*/
+	void InitArray()
+	{
+		/// Create the generator
+		std::random_device rd;
+		std::mt19937 gen( rd() );
+
+		/// Set the distribution for the generator
+		std::uniform_int_distribution<std::size_t> sizeDist( 50, 200 );
+
+		/// Clear array and set size to 0
+		ResetArray();
+
+		/// Generate the random size of array between 50 and 200
+		szArray = sizeDist( gen );
+
+		/// Generate random array elements between 0 and 100
+		for ( std::size_t i = 0; i < szArray; i++ )
+		{
+			array.emplace_back( RandomValue( gen, 0, 100 ) );
+		}
+		UseArray();
+	}
+
+	/**
+	* @brief Initialize array with a set size, elements
+	* are generated with the current distribution
+	*
+	* Values are between 0 and size, so large
+	* arrays don't end up being mostly duplicates
+	*
+	* @param size Number of elements to generate
+	*/
+	void InitArray( const std::size_t size )
+	{
+		/// Create the generator
+		std::random_device rd;
+		std::mt19937 gen( rd() );
+
+		/// Clear array and set size
+		ResetArray();
+		szArray = size;
+		array.resize( size );
+
+		/// Max value, capped at the max of T for integers
+		std::size_t valueCap = std::max< std::size_t >( size, 100 );
+		if constexpr ( std::is_integral_v<T> )
+		{
+			valueCap = std::min< std::size_t >( valueCap, ( std::numeric_limits<T>::max )() );
+		}
+		const T maxValue = static_cast< T >( valueCap );
+
+		GenerateDistribution( gen, maxValue );
+		UseArray();
+	}
+
+	/**
+	* @brief Uses a binary file of T as the array, without copying it
+	*
+	* The file is memory mapped and the algorithms run straight on the mapped
+	* pages, so real data sets bigger than the page cache can be sorted and
+	* searched. Pages are read in as they are touched. Bytes past the last
+	* whole T are ignored.
+	*
+	* @param path File of raw T values
+	* @param mode CopyOnWrite keeps the file as is, WriteThrough lets sorts change it
+	* @param hint How the algorithms will read the data, see AdviseArray
+	* @throws std::runtime_error If the file can't be opened or mapped
+	*/
+	void LoadArray( const std::filesystem::path& path, const MapMode mode = MapMode::CopyOnWrite,
+					const AccessHint hint = AccessHint::Sequential )
+	{
+		ResetArray();
+		mappedFile.Open( path, mode, hint );
+		view = mappedFile.As<T>();
+		szArray = view.size();
+	}
+
+	/**
+	* @brief Tells the OS how the loaded file is about to be read
+	*
+	* Sorts and scans read sequentially, binary searches jump around.
+	* Does nothing if the array wasn't loaded from a file.
+	*
+	* @param hint How the pages will be read
+	*/
+	void AdviseArray( const AccessHint hint ) const
+	{
+		mappedFile.Advise( hint );
+	}
+
+	/**
+	* @brief Checks if the array is a loaded file
+	*
+	* @return true if LoadArray mapped a non empty file
+	*/
+	bool IsArrayMapped() const
+	{
+		return mappedFile.IsOpen();
+	}
+
+	/**
+	* @brief Resets array details, unmapping any loaded file
+	*/
+	void ResetArray()
+	{
+		tempBuffer.clear();
+		array.clear();
+		view = {};
+		mappedFile.Close();
+		szArray = 0;
+	}
+
+	/**
+	* @brief Xor Swap algorithm
+	*
+	* This is used as to not use a temporary variable,
+	* floating point types can't be xor'd so they use std::swap
+	*
+	* @param a First value to swap
+	* @param b Second value to swap
+	*/
+	void XorSwap( T& a, T& b ) const
+	{
+		/// Short circuit
+		if ( a == b ) return;
+
+		/// Swap
+		if constexpr ( std::is_integral_v<T> )
+		{
+			a ^= b;
+			b ^= a;
+			a ^= b;
+		} else
+		{
+			std::swap( a, b );
+		}
+	}
+
+
+	/**
+	* @brief Print array elements
+	*
+	* If original is true, print original array,
+	* else print sorted array.
+	* Prints in traditional array format with 16 values per line.
+	*
+	* @param original If true, prints original array; if false, prints sorted array
+	*/
+	void PrintArray( const bool& original = true ) const
+	{
+		const std::size_t elementsPerLine = 16;  /// Number of elements to print per line
+
+		std::println( "================================================================" );
+		if ( original )
+		{
+			std::print( "Original array = " );
+		} else
+		{
+			std::print( "Sorted array = " );
+		}
+
+		std::print( "{ \n" );
+
+		for ( std::size_t i = 0; i < szArray; i++ )
+		{
+			/// Print the current element
+			std::print("{}", view[ i ]);
+
+			/// Decide what separator to use
+			if ( i == szArray - 1 )
+			{
+				/// Last element gets no comma
+				std::print( "" );
+			} else
+			{
+				std::print( ", " );
+
+				/// Add a line break after every elementsPerLine elements (except at the end)
+				if ( ( i + 1 ) % elementsPerLine == 0 && i < szArray - 1 )
+				{
+					std::println( "\r " );  // New line with a space for indentation
+				}
+			}
+		}
+
+		std::println( " };" );
+		std::println( "================================================================" );
+	}
+
+
+	/**
+	* @brief Prints the sort name
+	*
+	* @param sortName Name of the sorting algorithm to display
+	*/
+	void PrintAlgoName( const std::string& sortName ) const
+	{
+		std::println( "================================================================" );
+		std::println( "{}", sortName );
+	}
+
+protected:
+
+	/**
+	* @brief Points the view at array, call after array is changed
+	*/
+	void UseArray()
+	{
+		view = array;
+		szArray = array.size();
+	}
+
+	/**
+	* @brief Gets a uniform random value, this picks the
+	* int or real distribution depending on T
+	*
+	* @param gen Our generator
+	* @param low Lowest value
+	* @param high Highest value
+	* @return The random value
+	*/
+	static T RandomValue( std::mt19937& gen, const T low, const T high )
+	{
+		if constexpr ( std::is_floating_point_v<T> )
+		{
+			return std::uniform_real_distribution<T>( low, high )( gen );
+		} else
+		{
+			return std::uniform_int_distribution<T>( low, high )( gen );
+		}
+	}
+
+	/**
+	* @brief Fills the whole array with the current distribution
+	*
+	* @param gen Our generator
+	* @param maxValue Largest value to generate
+	*/
+	void GenerateDistribution( std::mt19937& gen, const T maxValue )
+	{
+		const std::size_t size = array.size();
+		if ( size == 0 )
+		{
+			return;
+		}
+
+		switch ( distribution )
+		{
+			case Distribution::Uniform:
+			{
+				for ( T& value : array )
+				{
+					value = RandomValue( gen, 0, maxValue );
+				}
+				break;
+			}
+			case Distribution::Sorted:
+			case Distribution::Reverse:
+			case Distribution::NearlySorted:
+			{
+				for ( T& value : array )
+				{
+					value = RandomValue( gen, 0, maxValue );
+				}
+
+				if ( distribution == Distribution::Reverse )
+				{
+					std::ranges::sort( array, std::ranges::greater() );
+				} else
+				{
+					std::ranges::sort( array );
+				}
+
+				if ( distribution == Distribution::NearlySorted )
+				{
+					/// Swap 1% of the elements with random partners
+					std::uniform_int_distribution<std::size_t> indexDist( 0, size - 1 );
+					for ( std::size_t i = 0; i < std::max< std::size_t >( size / 100, 1 ); ++i )
+					{
+						std::swap( array[ indexDist( gen ) ], array[ indexDist( gen ) ] );
+					}
+				}
+				break;
+			}
+			case Distribution::FewUnique:
+			{
+				/// 16 evenly spaced values across the range
+				constexpr int uniqueValues = 16;
+				std::uniform_int_distribution<int> bucketDist( 0, uniqueValues - 1 );
+				const T step = std::max< T >( maxValue / uniqueValues, 1 );
+				for ( T& value : array )
+				{
+					value = static_cast< T >( bucketDist( gen ) * step );
+				}
+				break;
+			}
+			case Distribution::Sawtooth:
+			{
+				const std::size_t period = std::max< std::size_t >( size / 16, 2 );
+				for ( std::size_t i = 0; i < size; ++i )
+				{
+					array[ i ] = static_cast< T >( i % period );
+				}
+				break;
+			}
+			case Distribution::OrganPipe:
+			{
+				for ( std::size_t i = 0; i < size; ++i )
+				{
+					array[ i ] = static_cast< T >( i < size / 2 ? i : size - 1 - i );
+				}
+				break;
+			}
+			case Distribution::Zipf:
+			{
+				/// Rank k is picked with weight 1 / k, we cap
+				/// the ranks so the table stays small
+				const std::size_t ranks = std::min< std::size_t >( static_cast< std::size_t >( maxValue ) + 1, 1 << 16 );
+				std::discrete_distribution<std::size_t> zipfDist( ranks, 0.0, static_cast< double >( ranks ),
+					[]( const double rank ) { return 1.0 / ( rank + 0.5 ); } );
+				for ( T& value : array )
+				{
+					value = static_cast< T >( zipfDist( gen ) );
+				}
+				break;
+			}
+			case Distribution::AllEqual:
+			{
+				std::ranges::fill( array, static_cast< T >( maxValue / 2 ) );
+				break;
+			}
+		}
+	}
+};
+
+
+/*
+* @brief Constraint for our linked list base class
+* 
+* @tparam T this is required to be std::string or std::wstring
+*/
+template< typename T >
+concept StringType = std::is_same_v< T, std::string > || 
+std::is_same_v< T, std::wstring >;
+
+
+/**
+* @brief This function gets lower case version of strings,
+* and compares them for alphabetical order.
+*
+* Shared by the linked list layouts so they all sort the same way
+*
+* @param nameOne The first name to compare.
+* @param nameTwo The second name to compare.
+* @return int
+* - Negative number if nameOne comes before nameTwo.
+* - Positive number if nameTwo comes before nameOne.
+* - 0 if both names are the same.
+*/
+template< typename T >
+	requires StringType< T >
+constexpr int CompareNames( const T& nameOne, const T& nameTwo )
+{
+	const std::size_t szL1 = nameOne.length();
+	const std::size_t szL2 = nameTwo.length();
+	uint32_t nL1 = '*';
+	uint32_t nL2 = '*';
+
+	for ( std::size_t i = 0; ( szL1 >= szL2 ) ? i < szL1 : i < szL2; ++i )
+	{
+		// If the current letter is a upper case
+		// We assign the lower case letter
+		// Else we just assign the letter
+		if ( i < szL1 && ( ( nameOne[ i ] < 0x005B ) && ( nameOne[ i ] > 0x0040 ) ) )
+		{
+			nL1 = nameOne[ i ] ^ 0x0020;
+		} else if ( i < szL1 )
+		{
+			nL1 = nameOne[ i ];
+		}
+
+		if ( i < szL2 && ( ( nameTwo[ i ] < 0x005B ) && ( nameTwo[ i ] > 0x0040 ) ) )
+		{
+			nL2 = nameTwo[ i ] ^ 0x0020;
+		} else if ( i < szL2 )
+		{
+			nL2 = nameTwo[ i ];
+		}
+
+		// Check for letter difference
+		if ( nL1 < nL2 )
+		{
+			return -1;
+		} else if ( nL2 < nL1 )
+		{
+			return 1;
+		} else
+		{
+			nL1 = '*';
+			nL2 = '*';
+		}
+	}
+	return 0;
+}
+
+
+/**
+* @brief Hash of a name that ignores case the way CompareNames does,
+* so names it calls the same land in the same slot
+*
+* @tparam T must be std::string or std::wstring
+*/
+template< typename T >
+	requires StringType< T >
+struct NameHash
+{
+	std::size_t operator()( const T& name ) const
+	{
+		/// FNV-1a over the lower case letters
+		std::uint64_t hash = 0xCBF29CE484222325ull;
+		for ( const auto letter : name )
+		{
+			const std::uint32_t lower = ( letter < 0x005B && letter > 0x0040 ) ? letter ^ 0x0020 : letter;
+			hash = ( hash ^ lower ) * 0x100000001B3ull;
+		}
+		return static_cast< std::size_t >( hash );
+	}
+};
+
+/**
+* @brief Equality of names that ignores case, see CompareNames
+*
+* @tparam T must be std::string or std::wstring
+*/
+template< typename T >
+	requires StringType< T >
+struct NameEqual
+{
+	bool operator()( const T& nameOne, const T& nameTwo ) const
+	{
+		return nameOne.length() == nameTwo.length() && CompareNames( nameOne, nameTwo ) == 0;
+	}
+};
+
+
+/// Handle of a name in a StringTable
+using NameHandle = std::uint32_t;
+
+
+/**
+* @brief Interning table for the names of a linked list
+*
+* Each distinct name is stored once and nodes keep a 32 bit handle to
+* it. Two handles being the same means the same name, so most compares
+* of equal names never look at the text.
+*
+* Every name also gets a collation key when it is interned, the first
+* few letters folded to lower case and packed into 64 bits so comparing
+* keys orders names the same way CompareNames does. Names that differ in
+* those letters are ordered by one integer compare, only names that share
+* the whole key and are too long for it fall back to CompareNames.
+*
+* Handles stay valid for the life of the table, names are never removed.
+* Handle 0 is the empty name.
+*
+* @tparam T must be std::string or std::wstring
+*/
+template< typename T >
+	requires StringType< T >
+class StringTable
+{
+public:
+	using Letter = typename T::value_type;
+
+	/// Bits each letter takes in a collation key, wide letters from 0xFFFF on cap the rest of the key
+	static constexpr std::size_t KEY_LETTER_BITS = sizeof( Letter ) == 1 ? 8 : 16;
+	/// Letters a collation key holds
+	static constexpr std::size_t KEY_LETTERS = 64 / KEY_LETTER_BITS;
+
+	/**
+	* @brief Packed prefix of a name in CompareNames order
+	*/
+	struct CollationKey
+	{
+		std::uint64_t prefix = 0; //< First KEY_LETTERS letters, lower case, padded like CompareNames
+		bool exact = true; //< True when the prefix holds the whole name
+	};
+
+	/**
+	* @brief A name ready to compare against interned names
+	*/
+	struct NameKey
+	{
+		const T* text = nullptr; //< The name
+		CollationKey collation; //< Its collation key
+		NameHandle handle = ( std::numeric_limits<NameHandle>::max )(); //< Its handle, max if not interned
+	};
+
+private:
+	/**
+	* @brief One interned name
+	*/
+	struct Entry
+	{
+		T name; //< The name
+		CollationKey collation; //< Its collation key
+	};
+
+	std::vector< Entry > entries; //< Interned names, by handle
+	OpenHashMap< T, NameHandle > handles; //< Handle of each interned name
+
+public:
+	/**
+	* @brief Constructor, interns the empty name as handle 0
+	*/
+	StringTable()
+	{
+		Intern( T() );
+	}
+
+	/// Distinct names interned
+	std::size_t Size() const { return entries.size(); }
+
+
+	/**
+	* @brief Gets the handle of a name, interning it if it is new
+	*
+	* @param name The name
+	* @return Handle of the name
+	*/
+	NameHandle Intern( const T& name )
+	{
+		if ( const NameHandle* found = handles.Find( name ) )
+		{
+			return *found;
+		}
+
+		const NameHandle handle = static_cast< NameHandle >( entries.size() );
+		entries.push_back( { name, MakeCollationKey( name ) } );
+		handles.Insert( name, handle );
+		return handle;
+	}
+
+	/**
+	* @brief Gets the name of a handle
+	*
+	* @param handle Handle from this table
+	* @return The name
+	*/
+	const T& Name( const NameHandle handle ) const
+	{
+		return entries[ handle ].name;
+	}
+
+	/**
+	* @brief Gets the compare key of an interned name
+	*/
+	NameKey KeyOf( const NameHandle handle ) const
+	{
+		return NameKey{ &entries[ handle ].name, entries[ handle ].collation, handle };
+	}
+
+	/**
+	* @brief Gets the compare key of any name, it doesn't get interned
+	*
+	* @param name The name, must outlive the key
+	*/
+	NameKey KeyOf( const T& name ) const
+	{
+		const NameHandle* found = handles.Find( name );
+		return NameKey{ &name, MakeCollationKey( name ), found != nullptr ? *found : ( std::numeric_limits<NameHandle>::max )() };
+	}
+
+
+	/**
+	* @brief Compares two interned names, see CompareNames
+	*
+	* @return Negative if one comes first, positive if two does, 0 if they are the same
+	*/
+	int Compare( const NameHandle one, const NameHandle two ) const
+	{
+		return Compare( one, KeyOf( two ) );
+	}
+
+	/**
+	* @brief Compares an interned name with a key, see CompareNames
+	*
+	* @param handle Handle of the first name
+	* @param key Key of the second name
+	* @return Negative if handle comes first, positive if key does, 0 if they are the same
+	*/
+	int Compare( const NameHandle handle, const NameKey& key ) const
+	{
+		if ( handle == key.handle )
+		{
+			return 0;
+		}
+
+		const Entry& entry = entries[ handle ];
+		if ( entry.collation.prefix != key.collation.prefix )
+		{
+			return entry.collation.prefix < key.collation.prefix ? -1 : 1;
+		}
+		if ( entry.collation.exact && key.collation.exact )
+		{
+			return 0;
+		}
+		return CompareNames( entry.name, *key.text );
+	}
+
+	/**
+	* @brief Builds the collation key of a name
+	*
+	* Letters are lower cased and compared as unsigned like CompareNames,
+	* and past the end of the name we pad with the '*' it compares with.
+	* A wide letter that doesn't fit fills the rest of the key with the
+	* biggest letter, so the letters after it can't decide the order and
+	* names that tie there fall back to CompareNames.
+	*
+	* @param name The name
+	* @return Its collation key
+	*/
+	static CollationKey MakeCollationKey( const T& name )
+	{
+		constexpr std::uint32_t MAX_LETTER = ( 1u << KEY_LETTER_BITS ) - 1;
+
+		CollationKey key;
+		key.exact = name.length() <= KEY_LETTERS;
+		bool capped = false;
+		for ( std::size_t i = 0; i < KEY_LETTERS; ++i )
+		{
+			std::uint32_t letter = '*';
+			if ( capped )
+			{
+				letter = MAX_LETTER;
+			} else if ( i < name.length() )
+			{
+				letter = ( name[ i ] < 0x005B && name[ i ] > 0x0040 ) ? name[ i ] ^ 0x0020 : static_cast< std::uint32_t >( name[ i ] );
+				if constexpr ( sizeof( Letter ) == 1 )
+				{
+					/// Negative chars compare above ASCII either way
+					letter &= MAX_LETTER;
+				} else if ( letter >= MAX_LETTER )
+				{
+					/// 0xFFFF and everything past it tie here, CompareNames orders them
+					letter = MAX_LETTER;
+					capped = true;
+					key.exact = false;
+				}
+			}
+			key.prefix = ( key.prefix << KEY_LETTER_BITS ) | letter;
+		}
+		return key;
+	}
+};
+
+
+
+/**
+* @brief Node structure for a doubly-linked list of string elements
+* Contains the handle of a name, an entry number, and pointers to the next
+* and previous nodes in the linked list.
+*
+* @details The name itself lives in the list's StringTable, so the
+* node is small and has nothing to destroy
+*
+* @tparam T must be std::string or std::wstring, the type of the names
+*/
+template< typename T >
+	requires StringType< T >
+struct StringNode
+{
+	NameHandle name = 0; //< Handle of the name in the list's StringTable
+	int entryNum = 0; //< Entry number/identifier for this node
+	StringNode* flink = nullptr; //< Forward link to the next node
+	StringNode* blink = nullptr; //< Backward link to the previous node
+
+	/**
+	* @brief Default constructor
+	*
+	* Creates an empty node with default values
+	*/
+	StringNode() = default;
+
+	/**
+	* @brief Parameterized constructor
+	*
+	* Creates a node with specified values
+	*
+	* @param entryNumber The identifier number for this node
+	* @param newName Handle of the name to store in this node
+	* @param newBlink Pointer to the previous node in the list
+	*/
+	StringNode( int entryNumber, NameHandle newName, StringNode* newBlink ):
+		name( newName ), entryNum( entryNumber ), blink( newBlink ) {}
+};
+
+
+
+/**
+* @brief Which order the entries of a linked list are in,
+* this is what its skip list index can search by
+*/
+enum class ListOrder
+{
+	Unordered, //< No order we can search by, the index is empty
+	EntryNum, //< Ascending entry number, the order entries are added in
+	Name //< Ascending name, equal names by entry number, see CompareNames
+};
+
+
+/**
+* @brief Skip list index layered over the chain of a linked list
+*
+* The chain itself is the bottom lane. About one entry in four gets a
+* tower standing on it, and each level of a tower is on the lane above
+* with a quarter of the towers of the one below. A search runs along the
+* top lane, drops a lane whenever the next tower is past the key, and
+* finishes with a short walk down the chain, so finding an entry is
+* O(log n) instead of walking the list.
+*
+* The index only works while the chain is in its order, ListOrder::EntryNum
+* or ListOrder::Name. Inserts and erases keep it up to date one entry at
+* a time, anything that reorders the chain has to call Build or Clear.
+*
+* @tparam T must be std::string or std::wstring
+*/
+template< typename T >
+	requires StringType< T >
+class SkipListIndex
+{
+public:
+	static constexpr std::size_t MAX_LEVEL = 16; //< Lanes above the chain, plenty for 4^16 entries
+
+private:
+	/**
+	* @brief Tower standing on one entry, with a link on each lane it reaches
+	*/
+	struct Tower
+	{
+		StringNode<T>* node = nullptr; //< Entry the tower stands on, nullptr for the header
+		std::array< Tower*, MAX_LEVEL > next{}; //< Next tower on each lane
+	};
+
+	/**
+	* @brief What we search for, in the index's order
+	*/
+	struct Key
+	{
+		typename StringTable<T>::NameKey name; //< Name, only used in ListOrder::Name
+		int entryNum = 0; //< Entry number, breaks ties between equal names
+	};
+
+	const StringTable<T>& table; //< Names of the list's entries
+	Tower header; //< Start of every lane
+	std::array< Tower*, MAX_LEVEL > tails; //< Last tower on each lane, the header on an empty lane
+	std::size_t levels = 0; //< Lanes in use
+	ListOrder order = ListOrder::Unordered; //< Order of the chain, Unordered when the index is empty
+	StringNode<T>* head = nullptr; //< Head of the list, it holds no entry
+	NodePool< Tower, 1024 > towerPool; //< Every tower comes from here
+	std::mt19937_64 gen{ std::random_device{}() }; //< Picks tower heights
+
+public:
+	/**
+	* @brief Constructor
+	*
+	* @param nameTable Names of the list's entries, must outlive the index
+	*/
+	explicit SkipListIndex( const StringTable<T>& nameTable ):
+		table( nameTable )
+	{
+		tails.fill( &header );
+	}
+
+	SkipListIndex( const SkipListIndex& ) = delete;
+	SkipListIndex& operator=( const SkipListIndex& ) = delete;
+
+	/// Order the index searches by
+	ListOrder Order() const { return order; }
+
+
+	/**
+	* @brief Rebuilds the index over a whole chain in one pass
+	*
+	* @param listHead Head of the list, the chain must already be in newOrder
+	* @param newOrder Order of the chain, Unordered just empties the index
+	*/
+	void Build( StringNode<T>* listHead, const ListOrder newOrder )
+	{
+		Clear();
+		head = listHead;
+		order = newOrder;
+		if ( order == ListOrder::Unordered )
+		{
+			return;
+		}
+
+		// Towers are added front to back so each one
+		// Goes on the end of every lane it reaches
+		for ( StringNode<T>* entry = head->flink; !IsEnd( entry ); entry = entry->flink )
+		{
+			const std::size_t height = RandomHeight();
+			if ( height == 0 )
+			{
+				continue;
+			}
+
+			Tower* tower = towerPool.Allocate();
+			tower->node = entry;
+			for ( std::size_t level = 0; level < height; ++level )
+			{
+				tails[ level ]->next[ level ] = tower;
+				tails[ level ] = tower;
+			}
+			levels = std::max( levels, height );
+		}
+	}
+
+	/**
+	* @brief Drops every tower, the index is Unordered until the next Build
+	*/
+	void Clear()
+	{
+		towerPool.Release();
+		header.next.fill( nullptr );
+		tails.fill( &header );
+		levels = 0;
+		order = ListOrder::Unordered;
+	}
+
+
+	/**
+	* @brief Finds the first entry with a name
+	*
+	* @param name The name to search for
+	* @return The entry, or nullptr if not found or the index isn't by name
+	*/
+	StringNode<T>* Find( const T& name ) const
+	{
+		if ( order != ListOrder::Name )
+		{
+			return nullptr;
+		}
+
+		/// Lowest entry number puts us before every entry with this name
+		const typename StringTable<T>::NameKey nameKey = table.KeyOf( name );
+		StringNode<T>* entry = Descend( Key{ nameKey, ( std::numeric_limits<int>::min )() }, nullptr )->flink;
+		if ( !IsEnd( entry ) && table.Compare( entry->name, nameKey ) == 0 )
+		{
+			return entry;
+		}
+		return nullptr;
+	}
+
+	/**
+	* @brief Finds the entry with an entry number
+	*
+	* @param entryNum The entry number to search for
+	* @return The entry, or nullptr if not found or the index isn't by entry number
+	*/
+	StringNode<T>* Find( const int entryNum ) const
+	{
+		if ( order != ListOrder::EntryNum )
+		{
+			return nullptr;
+		}
+
+		StringNode<T>* entry = Descend( Key{ {}, entryNum }, nullptr )->flink;
+		if ( !IsEnd( entry ) && entry->entryNum == entryNum )
+		{
+			return entry;
+		}
+		return nullptr;
+	}
+
+	/**
+	* @brief Finds where an entry that isn't linked in yet belongs
+	*
+	* @param entry The new entry
+	* @return The entry it goes after, the head if it goes first
+	*/
+	StringNode<T>* Predecessor( const StringNode<T>* entry ) const
+	{
+		return Descend( KeyOf( entry ), nullptr );
+	}
+
+
+	/**
+	* @brief Adds an entry that was just linked into the chain in order
+	*
+	* @param entry The new entry
+	*/
+	void Insert( StringNode<T>* entry )
+	{
+		if ( order == ListOrder::Unordered )
+		{
+			return;
+		}
+
+		const std::size_t height = RandomHeight();
+		if ( height == 0 )
+		{
+			return;
+		}
+
+		// An entry on the end of the chain goes on the end of every
+		// Lane, the usual case while adding in entry number order
+		Tower* update[ MAX_LEVEL ];
+		if ( IsEnd( entry->flink ) )
+		{
+			std::copy_n( tails.begin(), height, update );
+		} else
+		{
+			// New lanes start at the header
+			Descend( KeyOf( entry ), update );
+			for ( std::size_t level = levels; level < height; ++level )
+			{
+				update[ level ] = &header;
+			}
+		}
+		levels = std::max( levels, height );
+
+		Tower* tower = towerPool.Allocate();
+		tower->node = entry;
+		for ( std::size_t level = 0; level < height; ++level )
+		{
+			tower->next[ level ] = update[ level ]->next[ level ];
+			update[ level ]->next[ level ] = tower;
+			if ( tower->next[ level ] == nullptr )
+			{
+				tails[ level ] = tower;
+			}
+		}
+	}
+
+	/**
+	* @brief Removes an entry's tower, if it has one, call
+	* before the entry is unlinked from the chain
+	*
+	* @param entry The entry being removed
+	*/
+	void Erase( const StringNode<T>* entry )
+	{
+		if ( order == ListOrder::Unordered || levels == 0 )
+		{
+			return;
+		}
+
+		// Keys are unique, so if the entry has a tower it is the
+		// Next one after where the search stops on every lane
+		Tower* update[ MAX_LEVEL ];
+		Descend( KeyOf( entry ), update );
+
+		Tower* tower = update[ 0 ]->next[ 0 ];
+		if ( tower == nullptr || tower->node != entry )
+		{
+			return;
+		}
+
+		for ( std::size_t level = 0; level < levels && update[ level ]->next[ level ] == tower; ++level )
+		{
+			update[ level ]->next[ level ] = tower->next[ level ];
+			if ( tails[ level ] == tower )
+			{
+				tails[ level ] = update[ level ];
+			}
+		}
+		towerPool.Free( tower );
+
+		while ( levels > 0 && header.next[ levels - 1 ] == nullptr )
+		{
+			--levels;
+		}
+	}
+
+private:
+	/**
+	* @brief Checks for the end of the chain, the head
+	* on a wrapped list or nullptr on one that isn't
+	*/
+	bool IsEnd( const StringNode<T>* entry ) const
+	{
+		return entry == nullptr || entry == head;
+	}
+
+	/**
+	* @brief Gets an entry's key in the index's order
 	*/
-	void Start()
+	Key KeyOf( const StringNode<T>* entry ) const
 	{
-		start = Timer::type::now();
-		stop = start;
+		if ( order == ListOrder::Name )
+		{
+			return Key{ table.KeyOf( entry->name ), entry->entryNum };
+		}
+		return Key{ {}, entry->entryNum };
 	}
 
 	/**
-	* @brief Stop the timer
+	* @brief Compares an entry against a key in the index's order
 	*
-	* Records the current time as the stopping point
+	* @return Negative if the entry comes before the key, 0 if it is the key, else positive
 	*/
-	void Stop()
+	int Compare( const StringNode<T>* entry, const Key& key ) const
 	{
-		stop = Timer::type::now();
+		if ( order == ListOrder::Name )
+		{
+			const int compRes = table.Compare( entry->name, key.name );
+			if ( compRes != 0 )
+			{
+				return compRes;
+			}
+		}
+		return ( entry->entryNum > key.entryNum ) - ( entry->entryNum < key.entryNum );
 	}
 
 	/**
-	* @brief Get the elapsed time
-	*
-	* Calculates the time difference between start and stop points
+	* @brief Runs down the lanes then along the chain to the last entry before key
 	*
-	* @return The elapsed time in microseconds
+	* @param key What we are searching for
+	* @param update If not nullptr, receives the last tower before key on each lane in use
+	* @return The last entry before key, the head if there is none
 	*/
-	double GetElapsed() const
+	StringNode<T>* Descend( const Key& key, Tower** update ) const
 	{
-		return Microseconds( stop - start ).count();
+		const Tower* tower = &header;
+		for ( std::size_t level = levels; level-- > 0; )
+		{
+			while ( tower->next[ level ] != nullptr && Compare( tower->next[ level ]->node, key ) < 0 )
+			{
+				tower = tower->next[ level ];
+			}
+			if ( update != nullptr )
+			{
+				update[ level ] = const_cast< Tower* >( tower );
+			}
+		}
+
+		// About four entries between towers on the bottom lane
+		StringNode<T>* entry = tower->node != nullptr ? tower->node : head;
+		while ( !IsEnd( entry->flink ) && Compare( entry->flink, key ) < 0 )
+		{
+			entry = entry->flink;
+		}
+		return entry;
 	}
 
 	/**
-	* @brief prints start and stop times to console.
+	* @brief Picks how many lanes a new tower reaches,
+	* each lane with a quarter of the chance of the one below
+	*
+	* @return Height of the tower, 0 for no tower
 	*/
-	void PrintTimes() const
+	std::size_t RandomHeight()
 	{
-		std::println( "Start Time: {}, Stop Time: {}.",start.time_since_epoch().count(), stop.time_since_epoch().count() );
+		/// Two random bits per lane, the high bit caps us at MAX_LEVEL
+		return std::countr_zero( gen() | ( 1ull << ( 2 * MAX_LEVEL ) ) ) / 2;
 	}
 };
 
 
-/*
-* @brief Constraint for our algorithm base class
-* @tparam T this is required to be a integer or floating point
-* variable, or custom one that implements
-* std::numeric_limits::specialized characteristics properly
-*/
-template < typename T>
-concept NumericConstraint =
-std::numeric_limits<T>::is_specialized &&
-std::is_arithmetic_v<T>();
-
 
 /**
-* @brief Base class for searching and sorting algorithmns
-* It includes all the nessary functions needed for initializing
-* a vector of numerics with uniform randomness. This also includes
-* an xor based swap function, and the function needed to print the
-* array of data.
-* 
-* @tparam T Numeric type that meets the NumericConstraint requirement
+* @brief Hash indexes of a linked list's entries, by entry number and by name
+*
+* Entry numbers are unique, so that table maps each one straight to its
+* entry. Names repeat, so the name table maps each distinct name to a
+* bucket of the entries that have it. Every entry remembers where it sits
+* in its bucket, by entry number, so it can be swapped out in O(1).
+*
+* The index is off until Enable is called, after that Insert and Erase
+* keep it in sync with the list. It doesn't care what order the list is in.
+*
+* @tparam T must be std::string or std::wstring
 */
-template <typename T>
-	requires NumericConstraint<T>
-class AlgorithmsBase
+template< typename T >
+	requires StringType< T >
+class EntryHashIndex
 {
-protected:
-	std::size_t szArray = 0; //< Size of array 
-	std::vector<T> array; //< Our array
-	std::vector<T> tempBuffer; //< Temp buffer for quick sort
-	HighResTimer timer = HighResTimer(); //< timer for timing algorithms
+private:
+	static constexpr std::uint32_t NO_BUCKET = ( std::numeric_limits<std::uint32_t>::max )(); //< Handle not seen yet
 
+	const StringTable<T>& table; //< Names of the list's entries
+	bool enabled = false; //< Whether the list keeps us in sync
+	OpenHashMap< int, StringNode<T>* > byEntryNum; //< Entry of each entry number
+	OpenHashMap< T, std::uint32_t, NameHash<T>, NameEqual<T> > byName; //< Bucket of each distinct name
+	std::vector< std::vector< StringNode<T>* > > buckets; //< Entries that share a name
+	std::vector< std::uint32_t > bucketSlots; //< Where each entry is in its bucket, by entry number
+	std::vector< std::uint32_t > handleBuckets; //< Bucket of each name handle, so we only hash a name once
 
 public:
-
-
 	/**
-	* @brief Initialize array with random size and elements
+	* @brief Constructor, the index starts off
+	*
+	* @param nameTable Names of the list's entries, must outlive the index
 	*/
-	void InitArray()
-	{
-		/// Create the generator
-		std::random_device rd;
-		std::mt19937 gen( rd() );
-
-		/// Set the distribution for the generator
-		std::uniform_int_distribution<T> sizeDist( 50, 200 );
-		std::uniform_int_distribution<T> valueDist( 0, 100 );
+	explicit EntryHashIndex( const StringTable<T>& nameTable ):
+		table( nameTable ) {}
 
-		/// Clear array and set size to 0
-		ResetArray();
+	/// True when the list keeps the index in sync
+	bool Enabled() const { return enabled; }
 
-		/// Generate the random size of array between 50 and 200
-		szArray = sizeDist( gen );
 
-		/// Generate random array elements between 0 and 100
-		for ( T i = 0; i < szArray; i++ )
+	/**
+	* @brief Turns the index on and indexes every entry of a list
+	*
+	* @param head Head of the list
+	*/
+	void Enable( StringNode<T>* head )
+	{
+		Clear();
+		enabled = true;
+		for ( StringNode<T>* entry = head->flink; entry != nullptr && entry != head; entry = entry->flink )
 		{
-			array.emplace_back( valueDist( gen ) );
+			Insert( entry );
 		}
 	}
 
 	/**
-	* @brief Resets array details
+	* @brief Turns the index off and frees its tables
 	*/
-	void ResetArray()
+	void Disable()
 	{
-		tempBuffer.clear();
-		array.clear();
-		szArray = 0;
+		enabled = false;
+		byEntryNum = decltype( byEntryNum )();
+		byName = decltype( byName )();
+		buckets = {};
+		bucketSlots = {};
+		handleBuckets = {};
 	}
 
 	/**
-	* @brief Xor Swap algorithm
-	*
-	* This is used as to not use a temporary variable
-	*
-	* @param a First value to swap
-	* @param b Second value to swap
+	* @brief Removes every entry, the index stays on
 	*/
-	void XorSwap( T& a, T& b ) const
+	void Clear()
 	{
-		/// Short circuit
-		if ( a == b ) return;
-
-		/// Swap
-		a ^= b;
-		b ^= a;
-		a ^= b;
+		byEntryNum.Clear();
+		byName.Clear();
+		buckets.clear();
+		bucketSlots.clear();
+		handleBuckets.clear();
 	}
 
 
 	/**
-	* @brief Print array elements
+	* @brief Adds an entry that was just linked into the list
 	*
-	* If original is true, print original array,
-	* else print sorted array.
-	* Prints in traditional array format with 16 values per line.
-	*
-	* @param original If true, prints original array; if false, prints sorted array
+	* @param entry The new entry
 	*/
-	void PrintArray( const bool& original = true ) const
+	void Insert( StringNode<T>* entry )
 	{
-		const T elementsPerLine = 16;  /// Number of elements to print per line
-
-		std::println( "================================================================" );
-		if ( original )
-		{
-			std::print( "Original array = " );
-		} else
+		if ( !enabled )
 		{
-			std::print( "Sorted array = " );
+			return;
 		}
 
-		std::print( "{ \n" );
-
-		for ( T i = 0; i < szArray; i++ )
-		{
-			/// Print the current element
-			std::print("{}", array[ i ]);
+		byEntryNum.Insert( entry->entryNum, entry );
 
-			/// Decide what separator to use
-			if ( i == szArray - 1 )
-			{
-				/// Last element gets no comma
-				std::print( "" );
-			} else
-			{
-				std::print( ", " );
+		const std::uint32_t bucket = BucketOf( entry->name );
 
-				/// Add a line break after every elementsPerLine elements (except at the end)
-				if ( ( i + 1 ) % elementsPerLine == 0 && i < szArray - 1 )
-				{
-					std::println( "\r " );  // New line with a space for indentation
-				}
-			}
+		if ( static_cast< std::size_t >( entry->entryNum ) >= bucketSlots.size() )
+		{
+			bucketSlots.resize( static_cast< std::size_t >( entry->entryNum ) + 1 );
 		}
-
-		std::println( " };" );
-		std::println( "================================================================" );
+		bucketSlots[ entry->entryNum ] = static_cast< std::uint32_t >( buckets[ bucket ].size() );
+		buckets[ bucket ].push_back( entry );
 	}
 
-
 	/**
-	* @brief Prints the sort name
+	* @brief Removes an entry, call before the entry is freed
 	*
-	* @param sortName Name of the sorting algorithm to display
+	* @param entry The entry being removed
 	*/
-	void PrintAlgoName( const std::string& sortName ) const
+	void Erase( const StringNode<T>* entry )
 	{
-		std::println( "================================================================" );
-		std::println( "{}", sortName );
-	}
-};
-
-
-/*
-* @brief Constraint for our linked list base class
-* 
-* @tparam T this is required to be std::string or std::wstring
-*/
-template< typename T >
-concept StringType = std::is_same_v< T, std::string > || 
-std::is_same_v< T, std::wstring >;
-
+		if ( !enabled || !byEntryNum.Erase( entry->entryNum ) )
+		{
+			return;
+		}
 
+		// Swap the last entry of the bucket into our place
+		std::vector< StringNode<T>* >& bucket = buckets[ handleBuckets[ entry->name ] ];
+		const std::uint32_t slot = bucketSlots[ entry->entryNum ];
+		bucket[ slot ] = bucket.back();
+		bucketSlots[ bucket[ slot ]->entryNum ] = slot;
+		bucket.pop_back();
+	}
 
-/**
-* @brief Node structure for a doubly-linked list of string elements
-* Contains a name of string type, an entry number, and pointers to the next
-* and previous nodes in the linked list.
-*
-* @tparam T must be std::string or std::wstring
-*/
-template< typename T >
-	requires StringType< T >
-struct StringNode
-{
-	T name;              //< The string data stored in this node
-	int entryNum = 0; //< Entry number/identifier for this node
-	StringNode* flink = nullptr; //< Forward link to the next node
-	StringNode* blink = nullptr; //< Backward link to the previous node
 
 	/**
-	* @brief Default constructor
+	* @brief Finds the entry with an entry number
 	*
-	* Creates an empty node with default values
+	* @param entryNum The entry number to search for
+	* @return The entry, or nullptr if not found
 	*/
-	StringNode() = default;
+	StringNode<T>* Find( const int entryNum ) const
+	{
+		const auto found = byEntryNum.Find( entryNum );
+		return found != nullptr ? *found : nullptr;
+	}
 
 	/**
-	* @brief Parameterized constructor
+	* @brief Finds an entry with a name, when several have it
+	* this isn't necessarily the first in the list
 	*
-	* Creates a node with specified values
-	*
-	* @param entryNumber The identifier number for this node
-	* @param newName The string data to store in this node
-	* @param newBlink Pointer to the previous node in the list
+	* @param name The name to search for, case is ignored
+	* @return The entry, or nullptr if not found
 	*/
-	StringNode( int entryNumber, T newName, StringNode* newBlink ):
-		entryNum( entryNumber ), name( newName ), blink( newBlink ) {}
+	StringNode<T>* Find( const T& name ) const
+	{
+		const std::uint32_t* found = byName.Find( name );
+		if ( found == nullptr || buckets[ *found ].empty() )
+		{
+			return nullptr;
+		}
+		return buckets[ *found ].back();
+	}
 
+private:
 	/**
-	* @brief Destructor
+	* @brief Gets the bucket of a name handle, making one the first
+	* time its name is seen in any case
 	*
-	* Cleans up the node by nullifying pointers and resetting the entry number
-	* and clearing string
+	* @param handle Handle of the name
+	* @return Index of the bucket
 	*/
-	~StringNode()
+	std::uint32_t BucketOf( const NameHandle handle )
 	{
-		flink = blink = nullptr;
-		entryNum = 0;
-		name.clear();
+		if ( handle >= handleBuckets.size() )
+		{
+			handleBuckets.resize( static_cast< std::size_t >( handle ) + 1, NO_BUCKET );
+		}
+
+		std::uint32_t& bucket = handleBuckets[ handle ];
+		if ( bucket == NO_BUCKET )
+		{
+			// Names that only differ in case share a bucket
+			const T& name = table.Name( handle );
+			if ( const std::uint32_t* found = byName.Find( name ) )
+			{
+				bucket = *found;
+			} else
+			{
+				bucket = static_cast< std::uint32_t >( buckets.size() );
+				byName.Insert( name, bucket );
+				buckets.emplace_back();
+			}
+		}
+		return bucket;
 	}
 };
 
@@ -344,6 +1774,10 @@ protected:
 	int numOfEntries; //< Current number of entries in list( head is not included )
 	bool isListWrapped; //< Flag for telling wether the linked list is wrapped or not
 	HighResTimer timer;	//< timer for timing algorithms
+	NodePool< StringNode<T> > nodePool; //< Every node of the list, head included, comes from here
+	StringTable<T> nameTable; //< Every distinct name, nodes hold handles into this
+	SkipListIndex<T> index; //< Searches the list while it is in entry number or name order
+	EntryHashIndex<T> hashIndex; //< Optional O(1) lookups by entry number and name, see EnableHashIndex
 
 public:
 
@@ -354,7 +1788,8 @@ public:
 	* @param isWrapped flag to tell class wether 
 	* its a wrapped list or not
 	*/
-	explicit LinkListBase(const bool& isWrapped )
+	explicit LinkListBase(const bool& isWrapped ):
+		index( nameTable ), hashIndex( nameTable )
 	{
 		InitHead( isWrapped );
 	}
@@ -384,14 +1819,11 @@ public:
 		this->numOfEntries = 0;
 		
 		// Allocate the head
-		head = new StringNode<T>();
-		if ( head == nullptr )
-		{
-			// Return false if allocation failed
-			return false;
-		}
+		head = nodePool.Allocate();
 		// Set current to the head
 		current = head;
+		// Entries are added in entry number order
+		index.Build( head, ListOrder::EntryNum );
 		return true;
 	}
 
@@ -399,26 +1831,26 @@ public:
 	/**
 	* @brief Adds new entry to linked list
 	*
+	* A list sorted by name stays sorted, the index finds
+	* where the entry goes. Otherwise it goes on the end
+	*
 	* @tparam name The name to add to the new entry
 	* @return true if new entry was created else false
 	*/
 	bool AddEntry( T name )
 	{
 		// Allocate new entry
-		current->flink = new StringNode<T>( ++numOfEntries, name, current );
-		if ( current->flink == nullptr )
-		{
-			// Return false if allocation failed
-			return false;
-		}
+		StringNode<T>* entry = nodePool.Allocate( ++numOfEntries, nameTable.Intern( name ), nullptr );
+		StringNode<T>* prev = index.Order() == ListOrder::Name ? index.Predecessor( entry ) : current;
+		LinkAfter( prev, entry );
 		// Push current forward to new entry
-		current = current->flink;
-		// If the list is to be wrapped we reset the head
-		if ( isListWrapped )
+		// If it went on the end
+		if ( prev == current )
 		{
-			current->flink = head;
-			head->blink = current;
-		}		
+			current = entry;
+		}
+		index.Insert( entry );
+		hashIndex.Insert( entry );
 		return true;
 	}
 
@@ -483,44 +1915,67 @@ public:
 	*
 	* deletes head and sets head / current to nullptr,
 	* Sets count to zero
+	*
+	* @details The nodes memory goes back to the pool a
+	* block at a time, we only walk the list when the nodes
+	* have destructors to run
 	*/
 	void RemoveAllEntries()
 	{
-		// Set our loop entry to the second
-		// Entry in the list
-		StringNode<T>* entry = head->flink->flink;
-
-		// If the list is wrapped we can use the
-		// Head as our stop signal
-		// else we just check for nullptr
-		if ( isListWrapped )
+		if ( head == nullptr )
 		{
-			while ( entry != head )
-			{
-				// We delete the entries behind
-				// Us as we move forward through list
-				delete entry->blink;
-				// Push our entry to the next one
-				entry = entry->flink;
-			}
-		} else
+			return;
+		}
+
+		if constexpr ( !std::is_trivially_destructible_v< StringNode<T> > )
 		{
-			while ( entry != nullptr )
+			// Set our loop entry to the first
+			// Entry in the list
+			StringNode<T>* entry = head->flink;
+
+			// If the list is wrapped we can use the
+			// Head as our stop signal
+			// else we just check for nullptr
+			while ( entry != nullptr && entry != head )
 			{
-				// We delete the entries behind
-				// Us as we move forward through list
-				delete entry->blink;
-				// Push our entry to the next one
-				entry = entry->flink;
+				// Save the next entry, the destructor
+				// Clears the links
+				StringNode<T>* next = entry->flink;
+				std::destroy_at( entry );
+				entry = next;
 			}
-		}		
-		// Delete head to finish
-		delete head;
+			std::destroy_at( head );
+		}
+
+		// Give back every block to finish
+		index.Clear();
+		hashIndex.Clear();
+		nodePool.Release();
 		head = nullptr;
 		current = nullptr;
 		numOfEntries = 0;
 	}
 
+	/**
+	* @brief Turns on the hash indexes, RemoveEntry then finds
+	* entries in O(1) by entry number or name
+	*
+	* Every entry already in the list is indexed, entries added
+	* or removed from then on keep the index in sync
+	*/
+	void EnableHashIndex()
+	{
+		hashIndex.Enable( head );
+	}
+
+	/**
+	* @brief Turns off the hash indexes and frees them
+	*/
+	void DisableHashIndex()
+	{
+		hashIndex.Disable();
+	}
+
 	/*
 	* Abstract functions for derived classes
 	* To implement as we can add sorting and
@@ -533,6 +1988,43 @@ public:
 
 
 protected:
+	/**
+	* @brief Gets the name of an entry from the name table
+	*
+	* @param entry The entry
+	* @return Its name
+	*/
+	const T& NameOf( const StringNode<T>* entry ) const
+	{
+		return nameTable.Name( entry->name );
+	}
+
+	/**
+	* @brief Links an entry into the list after prev
+	*
+	* @param prev The entry to link after, the head to link first
+	* @param entry The entry to link in
+	*/
+	void LinkAfter( StringNode<T>* prev, StringNode<T>* entry )
+	{
+		entry->blink = prev;
+		entry->flink = prev->flink;
+		// The first entry of a wrapped list wraps back to the head
+		if ( isListWrapped && entry->flink == nullptr )
+		{
+			entry->flink = head;
+		}
+
+		if ( entry->flink == head )
+		{
+			head->blink = entry;
+		} else if ( entry->flink != nullptr )
+		{
+			entry->flink->blink = entry;
+		}
+		prev->flink = entry;
+	}
+
 	/**
 	* @brief Print the entries details
 	*
@@ -556,7 +2048,7 @@ protected:
 		std::println( "==============" );
 		std::println(
 		"Entry number: {}, Entry Name: {}",
-		entry->entryNum,std::string( entry->name.begin(), entry->name.end() ) );
+		entry->entryNum,std::string( NameOf( entry ).begin(), NameOf( entry ).end() ) );
 		std::println( "==============" );
 		return true;
 	}
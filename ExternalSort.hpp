@@ -0,0 +1,385 @@
+#ifndef EXTERNALSORT_HPP
+#define EXTERNALSORT_HPP
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <stdexcept>
+#include <algorithm>
+#include <random>
+
+
+/**
+* @brief Settings for SortingAlgorithms::ExternalSort
+*/
+struct ExternalSortConfig
+{
+    std::size_t memoryBytes = std::size_t( 1 ) << 30; //< Memory for sorting a run, the run and its temp buffer split it
+    std::size_t bufferBytes = std::size_t( 1 ) << 22; //< Read buffer per run while merging, and the output buffer
+    std::filesystem::path tempDirectory = std::filesystem::temp_directory_path(); //< Where runs are spilled
+};
+
+
+/**
+* @brief Reads up to count values of T from a binary file
+*
+* @param file File to read from
+* @param data Where to put the values
+* @param count Most values to read
+* @return Number of whole values read, 0 at the end of the file
+* @throws std::runtime_error If the read fails
+*/
+template <typename T>
+std::size_t ReadValues( std::ifstream& file, T* data, const std::size_t count )
+{
+    file.read( reinterpret_cast< char* >( data ), static_cast< std::streamsize >( count * sizeof( T ) ) );
+    if ( file.bad() )
+    {
+        throw std::runtime_error( "Failed to read from file.\n" );
+    }
+    return static_cast< std::size_t >( file.gcount() ) / sizeof( T );
+}
+
+
+/**
+* @brief Buffered reader over a binary file of T, one of the inputs of the merge
+*
+* Reads bufferBytes at a time, so the merge does large sequential reads from
+* every run instead of seeking back and forth between them
+*/
+template <typename T>
+class RunReader
+{
+private:
+    std::ifstream file; //< The run
+    std::vector<T> buffer; //< Block of the run we are reading from
+    std::size_t position = 0; //< Next element in buffer
+    std::size_t filled = 0; //< Elements in buffer
+
+public:
+    /**
+    * @brief Constructor, opens the file and reads the first block
+    *
+    * @param path File to read
+    * @param bufferElements Elements read per block, minimum of 1
+    * @throws std::runtime_error If the file can't be opened
+    */
+    RunReader( const std::filesystem::path& path, const std::size_t bufferElements ):
+        file( path, std::ios::binary ), buffer( std::max< std::size_t >( bufferElements, 1 ) )
+    {
+        if ( !file )
+        {
+            throw std::runtime_error( "Failed to open " + path.string() + " for reading.\n" );
+        }
+        Refill();
+    }
+
+    /// True once every element has been taken
+    bool Done() const { return position == filled; }
+
+    /// Current element, the reader must not be done
+    const T& Current() const { return buffer[ position ]; }
+
+    /**
+    * @brief Moves to the next element, reading the next block when needed
+    */
+    void Advance()
+    {
+        if ( ++position == filled )
+        {
+            Refill();
+        }
+    }
+
+private:
+    /**
+    * @brief Reads the next block and starts at its beginning
+    */
+    void Refill()
+    {
+        filled = ReadValues( file, buffer.data(), buffer.size() );
+        position = 0;
+    }
+};
+
+
+/**
+* @brief Buffered writer of a binary file of T
+*/
+template <typename T>
+class RunWriter
+{
+private:
+    std::ofstream file; //< The output
+    std::vector<T> buffer; //< Elements not written yet
+    std::size_t filled = 0; //< Elements in buffer
+
+public:
+    /**
+    * @brief Constructor, creates or truncates the file
+    *
+    * @param path File to write
+    * @param bufferElements Elements written per block, minimum of 1
+    * @throws std::runtime_error If the file can't be opened
+    */
+    RunWriter( const std::filesystem::path& path, const std::size_t bufferElements ):
+        file( path, std::ios::binary | std::ios::trunc ), buffer( std::max< std::size_t >( bufferElements, 1 ) )
+    {
+        if ( !file )
+        {
+            throw std::runtime_error( "Failed to open " + path.string() + " for writing.\n" );
+        }
+    }
+
+    /**
+    * @brief Destructor, writes anything left in the buffer
+    *
+    * Call Flush first if you want write errors as exceptions
+    */
+    ~RunWriter()
+    {
+        if ( filled > 0 )
+        {
+            file.write( reinterpret_cast< const char* >( buffer.data() ), filled * sizeof( T ) );
+        }
+    }
+
+    RunWriter( const RunWriter& ) = delete;
+    RunWriter& operator=( const RunWriter& ) = delete;
+
+    /**
+    * @brief Adds one element
+    *
+    * @param value Element to write
+    */
+    void Push( const T& value )
+    {
+        buffer[ filled++ ] = value;
+        if ( filled == buffer.size() )
+        {
+            Flush();
+        }
+    }
+
+    /**
+    * @brief Writes a whole block straight to the file, skipping the buffer
+    *
+    * @param data First element
+    * @param count Number of elements
+    */
+    void Write( const T* data, const std::size_t count )
+    {
+        Flush();
+        file.write( reinterpret_cast< const char* >( data ), count * sizeof( T ) );
+        CheckStream();
+    }
+
+    /**
+    * @brief Writes the buffer to the file
+    */
+    void Flush()
+    {
+        file.write( reinterpret_cast< const char* >( buffer.data() ), filled * sizeof( T ) );
+        filled = 0;
+        CheckStream();
+    }
+
+private:
+    /**
+    * @brief Throws if the last write failed
+    */
+    void CheckStream()
+    {
+        if ( !file )
+        {
+            throw std::runtime_error( "Failed to write sorted output.\n" );
+        }
+    }
+};
+
+
+/**
+* @brief Loser tree over k sorted runs, for the k way merge
+*
+* Each internal node holds the run that lost the match played there, and
+* node 0 holds the overall winner. Taking the winner and replaying its leaf
+* only touches the log2( k ) nodes on its path, with one compare per level,
+* where a binary heap needs two per level.
+*
+* A finished run loses to everything, so when the winner is finished the
+* merge is done.
+*/
+template <typename T>
+class LoserTree
+{
+private:
+    std::vector<RunReader<T>>& runs; //< The runs being merged
+    std::vector<std::size_t> losers; //< Node to run index, node 0 is the winner
+
+    /// Marks a node no run has reached yet while building
+    static constexpr std::size_t EMPTY = SIZE_MAX;
+
+public:
+    /**
+    * @brief Constructor, plays every leaf up the tree
+    *
+    * @param sources Runs to merge, at least one
+    */
+    explicit LoserTree( std::vector<RunReader<T>>& sources ): runs( sources ), losers( sources.size(), EMPTY )
+    {
+        for ( std::size_t run = 0; run < runs.size(); ++run )
+        {
+            Replay( run );
+        }
+    }
+
+    /**
+    * @brief Checks if every run is finished
+    *
+    * @return true if there is nothing left to merge
+    */
+    bool Done() const
+    {
+        return runs[ losers[ 0 ] ].Done();
+    }
+
+    /**
+    * @brief Gets the smallest element left in any run
+    *
+    * @return The element, the tree must not be done
+    */
+    const T& Top() const
+    {
+        return runs[ losers[ 0 ] ].Current();
+    }
+
+    /**
+    * @brief Removes the smallest element and plays its run's next element up the tree
+    */
+    void Pop()
+    {
+        const std::size_t winner = losers[ 0 ];
+        runs[ winner ].Advance();
+        Replay( winner );
+    }
+
+private:
+    /**
+    * @brief Checks if run a's element goes before run b's
+    *
+    * @param a Index of the first run
+    * @param b Index of the second run
+    * @return true if a wins, ties go to the lower run
+    */
+    bool Beats( const std::size_t a, const std::size_t b ) const
+    {
+        if ( runs[ a ].Done() )
+        {
+            return false;
+        }
+        if ( runs[ b ].Done() )
+        {
+            return true;
+        }
+        return runs[ a ].Current() < runs[ b ].Current() ||
+            ( !( runs[ b ].Current() < runs[ a ].Current() ) && a < b );
+    }
+
+    /**
+    * @brief Plays a run from its leaf to the root
+    *
+    * Leaves are nodes k to 2k - 1, so the parent of run r's leaf is ( r + k ) / 2.
+    * While building, a run stops at the first empty node and waits there for
+    * the winner of the other subtree.
+    *
+    * @param run Index of the run whose element changed
+    */
+    void Replay( std::size_t run )
+    {
+        for ( std::size_t node = ( run + runs.size() ) / 2; node > 0; node /= 2 )
+        {
+            if ( losers[ node ] == EMPTY )
+            {
+                losers[ node ] = run;
+                return;
+            }
+
+            /// The loser stays at the node, the winner plays on
+            if ( Beats( losers[ node ], run ) )
+            {
+                std::swap( run, losers[ node ] );
+            }
+        }
+        losers[ 0 ] = run;
+    }
+};
+
+
+/**
+* @brief Temp run files that are deleted when the sort finishes or throws
+*/
+class TempRunFiles
+{
+private:
+    std::filesystem::path directory; //< Where the runs go
+    std::string prefix; //< Random prefix so sorts running at the same time don't collide
+    std::vector<std::filesystem::path> paths; //< Every run file made so far
+    std::size_t nextRun = 0; //< Number for the next run name
+
+public:
+    /**
+    * @brief Constructor
+    *
+    * @param tempDirectory Directory to create the runs in
+    */
+    explicit TempRunFiles( const std::filesystem::path& tempDirectory ): directory( tempDirectory )
+    {
+        std::random_device rd;
+        prefix = "extsort-" + std::to_string( rd() ) + "-" + std::to_string( rd() );
+    }
+
+    /**
+    * @brief Destructor, deletes every run file
+    */
+    ~TempRunFiles()
+    {
+        for ( const auto& path : paths )
+        {
+            std::error_code ignored;
+            std::filesystem::remove( path, ignored );
+        }
+    }
+
+    TempRunFiles( const TempRunFiles& ) = delete;
+    TempRunFiles& operator=( const TempRunFiles& ) = delete;
+
+    /**
+    * @brief Gets a path for a new run
+    *
+    * @return Path of the run file
+    */
+    std::filesystem::path NewRun()
+    {
+        paths.push_back( directory / ( prefix + "-" + std::to_string( nextRun++ ) + ".run" ) );
+        return paths.back();
+    }
+
+    /**
+    * @brief Deletes a run once it has been merged
+    *
+    * @param path Run to delete
+    */
+    void Remove( const std::filesystem::path& path )
+    {
+        std::error_code ignored;
+        std::filesystem::remove( path, ignored );
+        std::erase( paths, path );
+    }
+};
+
+
+#endif // !EXTERNALSORT_HPP
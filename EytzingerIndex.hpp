@@ -0,0 +1,214 @@
+#ifndef EYTZINGERINDEX_HPP
+#define EYTZINGERINDEX_HPP
+
+
+#include "ClassBase.hpp"
+#include <span>
+#include <optional>
+#include <bit>
+#include <cstdint>
+
+
+/**
+* @brief Static search index over a sorted array in Eytzinger ( BFS ) order
+*
+* The sorted values are laid out like a binary heap, the root at index 1 and
+* the children of k at 2k and 2k + 1. The first few levels of every search
+* are the same handful of cache lines, so they stay hot, and the
+* 16 great great grandchildren of a node ( for 4 byte T ) share one cache
+* line, so we can prefetch four levels ahead while we compare.
+*
+* The tree is padded out to a full 2^h - 1 nodes with the biggest value of T.
+* That way every search is exactly h steps, and the sorted index of a node
+* falls straight out of its position with a few shifts.
+*
+* @tparam T Numeric type that meets the NumericConstraint requirement
+*
+* @note The index is a copy, rebuild it if the sorted array changes
+*/
+template <typename T>
+	requires NumericConstraint<T>
+class EytzingerIndex
+{
+private:
+	/// Size of a cache line in bytes, the tree starts on one
+	static constexpr std::size_t CACHE_LINE = 64;
+	/// Nodes per cache line, node k's descendants this many times further down share a line
+	static constexpr std::size_t PREFETCH_STRIDE = CACHE_LINE / sizeof( T );
+
+	std::vector<T, AlignedAllocator<T, CACHE_LINE>> tree; //< The padded tree, node 0 is unused and starts a cache line
+	std::size_t szSorted = 0; //< Size of the sorted array we were built from
+	std::size_t height = 0; //< Levels in the padded tree
+
+public:
+	/**
+	* @brief Default constructor, an empty index
+	*/
+	EytzingerIndex() = default;
+
+	/**
+	* @brief Constructor that builds the index
+	*
+	* @param sorted Sorted values to index
+	*/
+	explicit EytzingerIndex( std::span<const T> sorted )
+	{
+		Build( sorted );
+	}
+
+	/**
+	* @brief Rebuilds the index from a sorted array
+	*
+	* Node k at depth d holds sorted element
+	* ( ( 2 * ( k - 2^d ) + 1 ) << ( h - 1 - d ) ) - 1,
+	* or padding if that is past the end
+	*
+	* @param sorted Sorted values to index
+	*/
+	void Build( std::span<const T> sorted )
+	{
+		szSorted = sorted.size();
+		height = std::bit_width( szSorted );
+
+		/// Node 0 is unused, so node k * PREFETCH_STRIDE always starts a cache line
+		tree.assign( std::size_t( 1 ) << height, Padding() );
+
+		for ( std::size_t depth = 0; depth < height; ++depth )
+		{
+			const std::size_t levelStart = std::size_t( 1 ) << depth;
+			for ( std::size_t k = levelStart; k < levelStart * 2; ++k )
+			{
+				const std::size_t rank = NodeRank( k, depth );
+				if ( rank < szSorted )
+				{
+					tree[ k ] = sorted[ rank ];
+				}
+			}
+		}
+	}
+
+	/**
+	* @brief Gets the size of the sorted array the index was built from
+	*
+	* @return Number of indexed values
+	*/
+	std::size_t Size() const
+	{
+		return szSorted;
+	}
+
+	/**
+	* @brief Lower bound through the index
+	*
+	* @param value Value to search for
+	* @return Sorted index of the first element not less than value, or Size() if there is none
+	*/
+	std::size_t LowerBound( const T value ) const
+	{
+		return NodeIndex( Descend( value, []( const T& node, const T& key ) { return node < key; } ) );
+	}
+
+	/**
+	* @brief Upper bound through the index
+	*
+	* @param value Value to search for
+	* @return Sorted index of the first element greater than value, or Size() if there is none
+	*/
+	std::size_t UpperBound( const T value ) const
+	{
+		return NodeIndex( Descend( value, []( const T& node, const T& key ) { return !( key < node ); } ) );
+	}
+
+	/**
+	* @brief Looks a value up, the same as binary search on the sorted array
+	*
+	* @param value Value to search for
+	* @return std::nullopt if not found, else sorted index of the first match
+	*/
+	std::optional<std::size_t> Find( const T value ) const
+	{
+		/// The node is still in cache from the walk down, padding is ruled out by the index
+		const std::size_t k = Descend( value, []( const T& node, const T& key ) { return node < key; } );
+		const std::size_t index = NodeIndex( k );
+		if ( index < szSorted && tree[ k ] == value )
+		{
+			return index;
+		}
+		return std::nullopt;
+	}
+
+private:
+	/**
+	* @brief Value the tree is padded with, sorts after everything
+	*
+	* @return Infinity for floats, else the max of T
+	*/
+	static constexpr T Padding()
+	{
+		if constexpr ( std::numeric_limits<T>::has_infinity )
+		{
+			return std::numeric_limits<T>::infinity();
+		} else
+		{
+			return ( std::numeric_limits<T>::max )();
+		}
+	}
+
+	/**
+	* @brief Gets the sorted index of a node
+	*
+	* @param k Node index
+	* @param depth Depth of the node, the root is 0
+	* @return Sorted index, Size() or more for padding
+	*/
+	std::size_t NodeRank( const std::size_t k, const std::size_t depth ) const
+	{
+		return ( ( 2 * ( k - ( std::size_t( 1 ) << depth ) ) + 1 ) << ( height - 1 - depth ) ) - 1;
+	}
+
+	/**
+	* @brief Converts a node from Descend to a sorted index
+	*
+	* @param k Node index, 0 for none
+	* @return Sorted index of the node, or Size() for none or padding
+	*/
+	std::size_t NodeIndex( const std::size_t k ) const
+	{
+		if ( k == 0 )
+		{
+			return szSorted;
+		}
+		return std::min( NodeRank( k, std::bit_width( k ) - 1 ), szSorted );
+	}
+
+	/**
+	* @brief Walks the tree, shared by every lookup
+	*
+	* k goes left or right at each level with no branch. Once we fall
+	* out of the tree, the answer is the last node we went left at,
+	* which is k with its trailing right turns and one more bit dropped.
+	*
+	* @param value Value to search for
+	* @param goRight Returns true when the answer is after node
+	* @return Node of the answer, or 0 if we never went left
+	*/
+	template< typename GoRight >
+	std::size_t Descend( const T value, GoRight goRight ) const
+	{
+		const T* nodes = tree.data();
+		const auto treeAddress = reinterpret_cast< std::uintptr_t >( nodes );
+
+		std::size_t k = 1;
+		for ( std::size_t level = 0; level < height; ++level )
+		{
+			/// Done as an integer since near the leaves this is past the end of the tree
+			Prefetch( reinterpret_cast< const void* >( treeAddress + k * PREFETCH_STRIDE * sizeof( T ) ) );
+			k = 2 * k + goRight( nodes[ k ], value );
+		}
+
+		return k >> ( std::countr_one( k ) + 1 );
+	}
+};
+
+
+#endif // !EYTZINGERINDEX_HPP
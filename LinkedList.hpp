@@ -1,4 +1,5 @@
 #include "ClassBase.hpp"
+#include "UnrolledLinkedList.hpp"
 #include <generator>
 #include <thread>
 using namespace std::chrono_literals;
@@ -161,6 +162,141 @@ public:
 
 
 
+	/**
+	* @brief Benchmarks this node per entry list against UnrolledLinkedList
+	* with 16 and 64 entries per chunk, and prints the results as CSV
+	*
+	* Every layout gets the same random names. The searches look for
+	* the last entry number so a linear search walks the whole list,
+	* Middle Search is the node list's binary search without its skip
+	* list index. Remove finds the middle entry number and unlinks it,
+	* Hash Remove does the same through the hash index. Sort sorts by name.
+	*
+	* @param size Number of entries in the lists
+	* @param out Stream to write the CSV to
+	* @param runs Number of timed runs per operation
+	* @param warmup Number of untimed warmup runs per operation
+	*
+	* @note This list is left holding the benchmark entries
+	*/
+	void BenchmarkLayouts( const std::size_t size = 1 << 20, std::ostream& out = std::cout,
+						   const std::size_t runs = 5, const std::size_t warmup = 1 )
+	{
+		std::vector<T> names( size );
+		for ( T& name : names )
+		{
+			name = allNames[ rdNameDist( gen ) ];
+		}
+
+		const int lastEntry = static_cast< int >( size );
+		const int midEntry = static_cast< int >( size / 2 ) + 1;
+
+		BenchmarkRunner runner( warmup, runs );
+		BenchmarkRunner::PrintCsvHeader( out );
+
+		/// Node per entry, this list
+		const auto RebuildNodes = [ & ]()
+		{
+			this->RemoveAllEntries();
+			this->InitHead( this->isListWrapped );
+			for ( const T& name : names )
+			{
+				this->AddEntry( name );
+			}
+		};
+		const auto ResetNodes = [ & ]()
+		{
+			this->RemoveAllEntries();
+			this->InitHead( this->isListWrapped );
+		};
+		const auto AddNodes = [ & ]()
+		{
+			for ( const T& name : names )
+			{
+				this->AddEntry( name );
+			}
+		};
+
+		BenchmarkRunner::PrintCsvRow( out, "random_names", "Node List Build", runner.Run( size, ResetNodes, AddNodes ) );
+		RebuildNodes();
+		BenchmarkRunner::PrintCsvRow( out, "random_names", "Node List Linear Search", runner.Run( size, []() {}, [ & ]()
+		{
+			DoNotOptimize( LinearSearch( lastEntry ) );
+		} ) );
+		BenchmarkRunner::PrintCsvRow( out, "random_names", "Node List Binary Search", runner.Run( size, []() {}, [ & ]()
+		{
+			DoNotOptimize( BinarySearch( lastEntry ) );
+		} ) );
+		/// Without the index BinarySearch falls back to halving with GetListMiddle
+		this->index.Clear();
+		BenchmarkRunner::PrintCsvRow( out, "random_names", "Node List Middle Search", runner.Run( size, []() {}, [ & ]()
+		{
+			DoNotOptimize( BinarySearch( lastEntry ) );
+		} ) );
+		this->index.Build( this->head, ListOrder::EntryNum );
+		BenchmarkRunner::PrintCsvRow( out, "random_names", "Node List Remove", runner.Run( size, RebuildNodes, [ & ]()
+		{
+			DoNotOptimize( RemoveEntry( midEntry, false ) );
+		} ) );
+		BenchmarkRunner::PrintCsvRow( out, "random_names", "Node List Sort", runner.Run( size, RebuildNodes, [ & ]()
+		{
+			SortEntries();
+		} ) );
+		BenchmarkRunner::PrintCsvRow( out, "random_names", "Node List Hash Remove", runner.Run( size, [ & ]()
+		{
+			RebuildNodes();
+			this->EnableHashIndex();
+		}, [ & ]()
+		{
+			DoNotOptimize( RemoveEntry( midEntry, false ) );
+		} ) );
+		this->DisableHashIndex();
+
+		/// Unrolled, the same operations for each chunk size
+		const auto BenchUnrolled = [ & ]< std::size_t ChunkEntries >( const std::string_view name )
+		{
+			UnrolledLinkedList< T, ChunkEntries > list;
+			const auto Rebuild = [ & ]()
+			{
+				list.RemoveAllEntries();
+				for ( const T& entry : names )
+				{
+					list.AddEntry( entry );
+				}
+			};
+			const std::string prefix = std::string( name ) + " ";
+
+			BenchmarkRunner::PrintCsvRow( out, "random_names", prefix + "Build", runner.Run( size, [ & ]() { list.RemoveAllEntries(); }, [ & ]()
+			{
+				for ( const T& entry : names )
+				{
+					list.AddEntry( entry );
+				}
+			} ) );
+			Rebuild();
+			BenchmarkRunner::PrintCsvRow( out, "random_names", prefix + "Linear Search", runner.Run( size, []() {}, [ & ]()
+			{
+				DoNotOptimize( list.LinearSearch( lastEntry ).chunk );
+			} ) );
+			BenchmarkRunner::PrintCsvRow( out, "random_names", prefix + "Binary Search", runner.Run( size, []() {}, [ & ]()
+			{
+				DoNotOptimize( list.BinarySearch( lastEntry ).chunk );
+			} ) );
+			BenchmarkRunner::PrintCsvRow( out, "random_names", prefix + "Remove", runner.Run( size, Rebuild, [ & ]()
+			{
+				DoNotOptimize( list.RemoveEntry( midEntry, false ) );
+			} ) );
+			BenchmarkRunner::PrintCsvRow( out, "random_names", prefix + "Sort", runner.Run( size, Rebuild, [ & ]()
+			{
+				list.SortEntries();
+			} ) );
+		};
+
+		BenchUnrolled.template operator()< 16 >( "Unrolled List 16" );
+		BenchUnrolled.template operator()< 64 >( "Unrolled List 64" );
+	}
+
+
 
 private:
 
@@ -190,6 +326,8 @@ private:
 
 		// set our classes flipped list flag
 		this->listIsFlipped = true;
+		// Reversed the list isn't in any order the index can search
+		this->index.Clear();
 
 		// Set initial entry pointers
 		StringNode<T>* firstEntry = this->head->flink;
@@ -238,14 +376,19 @@ private:
 	*
 	* @param name The name to search for and remove
 	* @param binarSearch true if you want binary search,
-	* false, for linear search
+	* false, for linear search, ignored while the hash index is on
 	* @return int The entry number of the removed node, or -100 if not found
 	*/
 	T RemoveEntry( T name, const bool binarySearch )
 	{
 		StringNode<T>* node = nullptr;
 		
-		if ( binarySearch )
+		if ( this->hashIndex.Enabled() )
+		{
+			this->timer.Start();
+			node = this->hashIndex.Find( name );
+			this->timer.Stop();
+		} else if ( binarySearch )
 		{
 			this->timer.Start();
 			node = BinarySearch( name );
@@ -260,12 +403,9 @@ private:
 		
 		if ( node != nullptr )
 		{
-			T name = node->name;
-			int entryNum = node->entryNum;
-			node->blink->flink = node->flink;
-			node->flink->blink = node->blink;
-			node->blink = node->flink = nullptr;
-			delete node;
+			T name = this->NameOf( node );
+			UnlinkEntry( node );
+			this->nodePool.Free( node );
 			return name;
 		} else
 		{
@@ -278,14 +418,19 @@ private:
 	*
 	* @param name The name to search for and remove
 	* @param binarSearch true if you want binary search,
-	* false, for linear search
+	* false, for linear search, ignored while the hash index is on
 	* @return int The entry number of the removed node, or -100 if not found
 	*/
 	std::int32_t RemoveEntry( int entryNum, const bool binarySearch )
 	{		
 		StringNode<T>* node = nullptr;
 
-		if ( binarySearch )
+		if ( this->hashIndex.Enabled() )
+		{
+			this->timer.Start();
+			node = this->hashIndex.Find( entryNum );
+			this->timer.Stop();
+		} else if ( binarySearch )
 		{
 			this->timer.Start();
 			node = BinarySearch( entryNum );
@@ -301,10 +446,8 @@ private:
 		if ( node != nullptr )
 		{
 			std::int32_t entryNum = node->entryNum;
-			node->blink->flink = node->flink;
-			node->flink->blink = node->blink;
-			node->blink = node->flink = nullptr;
-			delete node;
+			UnlinkEntry( node );
+			this->nodePool.Free( node );
 			return entryNum;
 		} else
 		{
@@ -333,6 +476,14 @@ private:
 			return nullptr;
 		}
 		
+		// The name's key is worked out once, most
+		// Entries are then told apart by one compare
+		[[maybe_unused]] typename StringTable<T>::NameKey nameKey;
+		if constexpr ( std::is_same_v< ST, T > )
+		{
+			nameKey = this->nameTable.KeyOf( search );
+		}
+
 		StringNode<T>* pNode = this->head->flink;
 
 		// Loop through each entry and compare our search value with the 
@@ -348,7 +499,7 @@ private:
 				}
 			} else if constexpr ( std::is_same_v< ST, T > )
 			{
-				if ( CompNames( search, pNode->name ) == 0 )
+				if ( this->nameTable.Compare( pNode->name, nameKey ) == 0 )
 				{
 					return pNode;
 				}
@@ -369,6 +520,9 @@ private:
 	/**
 	* @brief Performs binary search on the linked list
 	*
+	* Goes through the skip list index when the list is in the
+	* order we search by, else halves the list with GetListMiddle
+	*
 	* @tparam ST Search type (int for entry number or T for name),
 	* the concept is at the top of this document
 	* @param search The value to search for
@@ -382,7 +536,31 @@ private:
 		{
 			return nullptr;
 		}
+
+		// The skip list index finds it in O(log n) when the
+		// List is in the order we are searching by
+		if constexpr ( std::is_same_v< ST, int > )
+		{
+			if ( this->index.Order() == ListOrder::EntryNum )
+			{
+				return this->index.Find( search );
+			}
+		} else if constexpr ( std::is_same_v< ST, T > )
+		{
+			if ( this->index.Order() == ListOrder::Name )
+			{
+				return this->index.Find( search );
+			}
+		}
 		
+		// The name's key is worked out once, most
+		// Entries are then told apart by one compare
+		[[maybe_unused]] typename StringTable<T>::NameKey nameKey;
+		if constexpr ( std::is_same_v< ST, T > )
+		{
+			nameKey = this->nameTable.KeyOf( search );
+		}
+
 		StringNode<T>* pMid = nullptr;
 		StringNode<T>* pLow = this->head->flink;
 		StringNode<T>* pHigh = this->head->blink;
@@ -417,7 +595,7 @@ private:
 			else if constexpr ( std::is_same_v< ST, T > )
 			{
 				// Get your string comparison result
-				auto compRes = CompNames( pMid->name, search );
+				auto compRes = this->nameTable.Compare( pMid->name, nameKey );
 				
 				// If they're the same we return
 				// Else if the middle entries name falls lower
@@ -534,7 +712,7 @@ private:
 		// Loop the chunk till the head and end meet
 		while ( chunk != nullptr && lastEntry != nullptr && chunk != lastEntry )
 		{
-			auto compRes = CompNames( chunk->name, lastEntry->name );
+			auto compRes = this->nameTable.Compare( chunk->name, lastEntry->name );
 
 			if ( compRes < 0 || ( compRes == 0 && chunk->entryNum < lastEntry->entryNum ) )
 			{
@@ -614,7 +792,7 @@ private:
 		// Loop through both chunks
 		while ( chunkOne != nullptr && chunkTwo != nullptr )
 		{
-			auto compRes = CompNames( chunkOne->name, chunkTwo->name );
+			auto compRes = this->nameTable.Compare( chunkOne->name, chunkTwo->name );
 
 			if ( compRes < 0 || ( compRes == 0 && chunkOne->entryNum < chunkTwo->entryNum ) )
 			{
@@ -691,84 +869,61 @@ private:
 	{
 		std::println( "==============Merge Sort, Linked List================" );
 		this->timer.Start();
+		SortEntries();
+		this->timer.Stop();
+		auto et = this->timer.GetElapsed();
+
+		std::println( "==============<Performance>================" );
+		std::println( "Number Of Entries: {}, \r\n Total Time: {}us,\n\r Time Per Entry: {}us", this->numOfEntries, et, et / this->numOfEntries );
+		std::println( "===========================================" );
+	}
+
+	/**
+	* @brief Merge sorts the list by name and re-wraps it if needed,
+	* without printing or timing
+	*/
+	constexpr void SortEntries()
+	{
 		if ( this->head->flink != nullptr && this->head->flink->flink != nullptr )
 		{
 			StringNode<T>* firstEntry = this->head->flink;
-			// Detach the head first
-			this->head->blink->flink = nullptr;
+			// Detach the head first, only a wrapped
+			// List has the last entry pointing at it
+			if ( this->isListWrapped )
+			{
+				this->head->blink->flink = nullptr;
+			}
 			this->head->flink = nullptr;
 			this->head->flink = MergeSort( firstEntry );
+			// The sort leaves the first entry's blink empty
+			this->head->flink->blink = this->head;
 		}
-		this->timer.Stop();
-		auto et = this->timer.GetElapsed();
-
 
 		if ( this->isListWrapped )
 		{
 			this->head->blink = GetLastEntry( this->head );
 			this->head->blink->flink = this->head;
+			this->current = this->head->blink;
+		} else
+		{
+			this->current = GetLastEntry( this->head );
 		}
 
-		std::println( "==============<Performance>================" );
-		std::println( "Number Of Entries: {}, \r\n Total Time: {}us,\n\r Time Per Entry: {}us", this->numOfEntries, et, et / this->numOfEntries );
-		std::println( "===========================================" );
+		// Index the new order
+		this->index.Build( this->head, ListOrder::Name );
 	}
 
 	///-----------------Utils----------------------///
 	/**
-	* @brief This function gets lower case version of strings,
-	* and compares them for alphabetical order.
-	*
+	* @brief Compares two names for alphabetical order, see CompareNames
 	*
 	* @param nameOne The first name to compare.
 	* @param nameTwo The second name to compare.
-	* @return int
-	* - Negative number if nameOne comes before nameTwo.
-	* - Positive number if nameTwo comes before nameOne.
-	* - 0 if both names are the same.
+	* @return Negative if nameOne comes first, positive if nameTwo does, 0 if the same
 	*/
 	constexpr int CompNames( const T& nameOne, const T& nameTwo ) const
 	{
-		const std::size_t szL1 = nameOne.length();
-		const std::size_t szL2 = nameTwo.length();
-		uint32_t nL1 = '*';
-		uint32_t nL2 = '*';
-
-		for ( std::size_t i = 0; ( szL1 >= szL2 ) ? i < szL1 : i < szL2; ++i )
-		{
-			// If the current letter is a upper case
-			// We assign the lower case letter
-			// Else we just assign the letter
-			if ( i < szL1 && ( ( nameOne[ i ] < 0x005B ) && ( nameOne[ i ] > 0x0040 ) ) )
-			{
-				nL1 = nameOne[ i ] ^ 0x0020;
-			} else if ( i < szL1 )
-			{
-				nL1 = nameOne[ i ];
-			}
-
-			if ( i < szL1 && ( ( nameTwo[ i ] < 0x005B ) && ( nameTwo[ i ] > 0x0040 ) ) )
-			{
-				nL2 = nameTwo[ i ] ^ 0x0020;
-			} else if ( i < szL2 )
-			{
-				nL2 = nameTwo[ i ];
-			}
-
-			// Check for letter difference
-			if ( nL1 < nL2 )
-			{
-				return -1;
-			} else if ( nL2 < nL1 )
-			{
-				return 1;
-			} else
-			{
-				nL1 = '*';
-				nL2 = '*';
-			}
-		}
-		return 0;
+		return CompareNames( nameOne, nameTwo );
 	}
 
 
@@ -794,6 +949,33 @@ private:
 	}
 
 
+	/**
+	* @brief Takes an entry out of the list and its index,
+	* the caller frees it
+	*
+	* @param node The entry to unlink
+	*/
+	void UnlinkEntry( StringNode<T>* node )
+	{
+		this->index.Erase( node );
+		this->hashIndex.Erase( node );
+		// Keep current on the last entry for AddEntry
+		if ( node == this->current )
+		{
+			this->current = node->blink;
+		}
+
+		node->blink->flink = node->flink;
+		// On a wrapped list this also points the
+		// Head back at the new last entry
+		if ( node->flink != nullptr )
+		{
+			node->flink->blink = node->blink;
+		}
+		node->blink = node->flink = nullptr;
+	}
+
+
 	/**
 	* @brief Gets the middle of our linked list
 	*
@@ -862,7 +1044,7 @@ private:
 			this->AddEntry( name );
 			if ( this->current->entryNum == rEntryNum )
 			{
-				this->searchName = this->current->name;
+				this->searchName = this->NameOf( this->current );
 			}
 		}
 	}
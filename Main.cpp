@@ -27,15 +27,30 @@ int main()
 	/// Our sorting algorithms class	
 	//auto sortAlgoS = std::make_unique< SortingAlgorithms< int > >();
 	//sortAlgoS->TestAllAlgorithms();
+	//sortAlgoS->BenchmarkAllAlgorithms();
+	//sortAlgoS->SweepAllAlgorithms();
+	//sortAlgoS->BenchmarkAllDistributions();
+	//sortAlgoS->BenchmarkParallelSpeedup();
+	//sortAlgoS->BenchmarkKeySort();
+	//sortAlgoS->BenchmarkColumnSort();
+	//sortAlgoS->BenchmarkSelection();
+	//sortAlgoS->BenchmarkExternalSort();
+	//sortAlgoS->BenchmarkFile( "data.bin" );
 
 
 	/// Our searching algorithms class
 	//auto searchAlgoS = std::make_unique< SearchAlogrithms< int > >();
 	//searchAlgoS->TestAllSearchAlgorithms();
+	//searchAlgoS->BenchmarkAllSearchAlgorithms();
+	//searchAlgoS->BenchmarkAllDistributions();
+	//searchAlgoS->BenchmarkSearchIndexSweep();
+	//searchAlgoS->BenchmarkParallelScan();
+	//searchAlgoS->LoadSearchData( "data.bin" );
 
 	/// Our linked list algorithmns class	
 	//auto linkedListAlgos = std::make_unique< LinkedListAlgorithms< std::string > >( true );
 	//linkedListAlgos->RunClassFunctions();
+	//linkedListAlgos->BenchmarkLayouts();
 
 	// Our standard binary tree algorithms class
 	//auto tester = std::make_unique<StandardBinaryTree>();
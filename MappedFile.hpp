@@ -0,0 +1,319 @@
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <utility>
+#include <filesystem>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+/**
+* @brief What writes to a mapped file do
+*/
+enum class MapMode
+{
+	CopyOnWrite, //< Written pages become private copies, the file is never changed
+	WriteThrough //< Writes go back to the file, sorting the mapping sorts the file
+};
+
+/**
+* @brief How the mapped pages are going to be read, passed on to the OS
+*/
+enum class AccessHint
+{
+	Normal, //< No hint, default read ahead
+	Sequential, //< Front to back, read ahead aggressively and drop pages behind us
+	Random, //< Jumping around, don't read ahead
+	WillNeed //< Start paging the whole file in now
+};
+
+
+/**
+* @brief File mapped into memory, so a binary file of T can be used
+* as an array without reading it into a buffer first
+*
+* Pages are loaded on first touch by the OS, so opening a huge file is instant
+* and only the parts that are used take memory.
+*
+* @note Files of 0 bytes aren't mapped, the view is just empty
+*/
+class MappedFile
+{
+private:
+	void* address = nullptr; //< Start of the mapping
+	std::size_t size = 0; //< Bytes mapped
+#ifdef _WIN32
+	HANDLE file = INVALID_HANDLE_VALUE; //< The open file
+	HANDLE mapping = nullptr; //< The file mapping object
+#endif
+
+public:
+	/**
+	* @brief Default constructor, nothing mapped
+	*/
+	MappedFile() = default;
+
+	/**
+	* @brief Constructor that maps a file
+	*
+	* @param path File to map
+	* @param mode What writes to the mapping do
+	* @param hint How the pages will be read
+	* @throws std::runtime_error If the file can't be opened or mapped
+	*/
+	MappedFile( const std::filesystem::path& path, const MapMode mode = MapMode::CopyOnWrite, const AccessHint hint = AccessHint::Normal )
+	{
+		Open( path, mode, hint );
+	}
+
+	/**
+	* @brief Destructor, unmaps the file
+	*/
+	~MappedFile()
+	{
+		Close();
+	}
+
+	MappedFile( const MappedFile& ) = delete;
+	MappedFile& operator=( const MappedFile& ) = delete;
+
+	/**
+	* @brief Move constructor, other is left empty
+	*/
+	MappedFile( MappedFile&& other ) noexcept
+	{
+		Swap( other );
+	}
+
+	/**
+	* @brief Move assignment, our old mapping is closed
+	*/
+	MappedFile& operator=( MappedFile&& other ) noexcept
+	{
+		if ( this != &other )
+		{
+			Close();
+			Swap( other );
+		}
+		return *this;
+	}
+
+	/**
+	* @brief Maps a file, anything already mapped is closed first
+	*
+	* @param path File to map
+	* @param mode What writes to the mapping do
+	* @param hint How the pages will be read
+	* @throws std::runtime_error If the file can't be opened or mapped
+	*/
+	void Open( const std::filesystem::path& path, const MapMode mode = MapMode::CopyOnWrite, const AccessHint hint = AccessHint::Normal )
+	{
+		Close();
+		const bool writeThrough = mode == MapMode::WriteThrough;
+
+#ifdef _WIN32
+		/// Windows only takes the read pattern when the file is opened
+		DWORD flags = FILE_ATTRIBUTE_NORMAL;
+		if ( hint == AccessHint::Sequential )
+		{
+			flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+		} else if ( hint == AccessHint::Random )
+		{
+			flags |= FILE_FLAG_RANDOM_ACCESS;
+		}
+
+		file = CreateFileW( path.c_str(), writeThrough ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+							FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr );
+		if ( file == INVALID_HANDLE_VALUE )
+		{
+			throw std::runtime_error( "Failed to open " + path.string() + " for mapping.\n" );
+		}
+
+		LARGE_INTEGER fileSize;
+		if ( !GetFileSizeEx( file, &fileSize ) )
+		{
+			Close();
+			throw std::runtime_error( "Failed to get the size of " + path.string() + ".\n" );
+		}
+		size = static_cast< std::size_t >( fileSize.QuadPart );
+		if ( size == 0 )
+		{
+			return;
+		}
+
+		mapping = CreateFileMappingW( file, nullptr, writeThrough ? PAGE_READWRITE : PAGE_WRITECOPY, 0, 0, nullptr );
+		address = mapping ? MapViewOfFile( mapping, writeThrough ? FILE_MAP_WRITE : FILE_MAP_COPY, 0, 0, 0 ) : nullptr;
+		if ( !address )
+		{
+			Close();
+			throw std::runtime_error( "Failed to map " + path.string() + ".\n" );
+		}
+#else
+		const int fd = ::open( path.c_str(), writeThrough ? O_RDWR : O_RDONLY );
+		if ( fd < 0 )
+		{
+			throw std::runtime_error( "Failed to open " + path.string() + " for mapping.\n" );
+		}
+
+		struct stat info;
+		if ( ::fstat( fd, &info ) != 0 )
+		{
+			::close( fd );
+			throw std::runtime_error( "Failed to get the size of " + path.string() + ".\n" );
+		}
+		size = static_cast< std::size_t >( info.st_size );
+		if ( size == 0 )
+		{
+			::close( fd );
+			return;
+		}
+
+		/// The mapping keeps its own reference to the file, the descriptor isn't needed after this
+		void* mapped = ::mmap( nullptr, size, PROT_READ | PROT_WRITE, writeThrough ? MAP_SHARED : MAP_PRIVATE, fd, 0 );
+		::close( fd );
+		if ( mapped == MAP_FAILED )
+		{
+			size = 0;
+			throw std::runtime_error( "Failed to map " + path.string() + ".\n" );
+		}
+		address = mapped;
+#endif
+
+		Advise( hint );
+	}
+
+	/**
+	* @brief Unmaps the file, written back first for WriteThrough
+	*/
+	void Close()
+	{
+#ifdef _WIN32
+		if ( address )
+		{
+			UnmapViewOfFile( address );
+		}
+		if ( mapping )
+		{
+			CloseHandle( mapping );
+		}
+		if ( file != INVALID_HANDLE_VALUE )
+		{
+			CloseHandle( file );
+		}
+		mapping = nullptr;
+		file = INVALID_HANDLE_VALUE;
+#else
+		if ( address )
+		{
+			::munmap( address, size );
+		}
+#endif
+		address = nullptr;
+		size = 0;
+	}
+
+	/**
+	* @brief Tells the OS how the pages are about to be read
+	*
+	* Call this again when the access pattern changes, say after a
+	* sequential sort and before random binary searches
+	*
+	* @param hint How the pages will be read
+	*/
+	void Advise( const AccessHint hint ) const
+	{
+		if ( !address )
+		{
+			return;
+		}
+
+#ifdef _WIN32
+		/// Windows has no per range read pattern once the file is open, prefetching is all we can ask for
+		if ( hint == AccessHint::WillNeed )
+		{
+			WIN32_MEMORY_RANGE_ENTRY range{ address, size };
+			PrefetchVirtualMemory( GetCurrentProcess(), 1, &range, 0 );
+		}
+#else
+		int advice = MADV_NORMAL;
+		switch ( hint )
+		{
+			case AccessHint::Normal: advice = MADV_NORMAL; break;
+			case AccessHint::Sequential: advice = MADV_SEQUENTIAL; break;
+			case AccessHint::Random: advice = MADV_RANDOM; break;
+			case AccessHint::WillNeed: advice = MADV_WILLNEED; break;
+		}
+		/// Only a hint, a failure here doesn't change what the mapping holds
+		::madvise( address, size, advice );
+#endif
+	}
+
+	/**
+	* @brief Checks if a file is mapped
+	*
+	* @return true if a non empty file is mapped
+	*/
+	bool IsOpen() const
+	{
+		return address != nullptr;
+	}
+
+	/**
+	* @brief Gets the number of bytes mapped
+	*
+	* @return Size of the file
+	*/
+	std::size_t Size() const
+	{
+		return size;
+	}
+
+	/**
+	* @brief Views the mapping as an array of T
+	*
+	* Bytes past the last whole T are left out
+	*
+	* @tparam T Element type of the file
+	* @return Span over the mapped elements, empty if nothing is mapped
+	*/
+	template <typename T>
+	std::span<T> As() const
+	{
+		if ( !address )
+		{
+			return {};
+		}
+		return std::span<T>( static_cast< T* >( address ), size / sizeof( T ) );
+	}
+
+private:
+	/**
+	* @brief Swaps the mapping with other
+	*
+	* @param other Mapping to swap with
+	*/
+	void Swap( MappedFile& other ) noexcept
+	{
+		std::swap( address, other.address );
+		std::swap( size, other.size );
+#ifdef _WIN32
+		std::swap( file, other.file );
+		std::swap( mapping, other.mapping );
+#endif
+	}
+};
+
+
+#endif // !MAPPEDFILE_HPP
@@ -0,0 +1,145 @@
+#ifndef NODEPOOL_HPP
+#define NODEPOOL_HPP
+
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+
+/**
+* @brief Slab allocator for the nodes of a linked structure
+*
+* Nodes are handed out from blocks of BlockNodes slots, so nodes made
+* one after the other sit next to each other in memory instead of
+* wherever the heap puts them. A freed node goes on a free list threaded
+* through its own slot and is the next one handed out.
+*
+* Blocks are only given back by Release or the destructor, all at once,
+* which costs one free per block. Release doesn't run destructors, the
+* owner destroys any live nodes that need it first.
+*
+* @tparam Node Type of the nodes
+* @tparam BlockNodes Nodes per block
+*/
+template< typename Node, std::size_t BlockNodes = 4096 >
+class NodePool
+{
+private:
+	/**
+	* @brief One slot of a block, a live node or a link in the free list
+	*/
+	union Slot
+	{
+		Slot* next; //< Next free slot, while this one is free
+		Node node; //< The node, while this one is handed out
+
+		Slot() : next( nullptr ) {}
+		~Slot() {}
+	};
+
+	static constexpr std::size_t BLOCK_ALIGNMENT = 64; //< Blocks start on a cache line
+
+	std::vector< Slot* > blocks; //< Every block we allocated
+	Slot* freeList = nullptr; //< Most recently freed slot
+	std::size_t used = BlockNodes; //< Slots handed out from the last block, full when there is none
+	std::size_t liveNodes = 0; //< Nodes handed out and not yet freed
+
+public:
+	NodePool() = default;
+
+	/**
+	* @brief Destructor, gives back every block
+	*/
+	~NodePool()
+	{
+		Release();
+	}
+
+	NodePool( const NodePool& ) = delete;
+	NodePool& operator=( const NodePool& ) = delete;
+
+	/**
+	* @brief Constructs a node in a free slot
+	*
+	* @param args Arguments for the node's constructor
+	* @return The new node
+	*/
+	template< typename... Args >
+	Node* Allocate( Args&&... args )
+	{
+		Slot* slot = nullptr;
+		if ( freeList != nullptr )
+		{
+			slot = freeList;
+			freeList = slot->next;
+		} else
+		{
+			if ( used == BlockNodes )
+			{
+				AddBlock();
+			}
+			slot = blocks.back() + used++;
+		}
+
+		Node* node = std::construct_at( &slot->node, std::forward< Args >( args )... );
+		++liveNodes;
+		return node;
+	}
+
+	/**
+	* @brief Destroys a node and puts its slot on the free list
+	*
+	* @param node Node from this pool
+	*/
+	void Free( Node* node )
+	{
+		std::destroy_at( node );
+
+		/// The node is the union's only other member, so its address is the slot's
+		Slot* slot = reinterpret_cast< Slot* >( node );
+		slot->next = freeList;
+		freeList = slot;
+		--liveNodes;
+	}
+
+	/**
+	* @brief Gives back every block without destroying the nodes in them
+	*
+	* Any node still live must have been destroyed already unless
+	* Node is trivially destructible. Every pointer from the pool is
+	* invalid after this.
+	*/
+	void Release()
+	{
+		for ( Slot* block : blocks )
+		{
+			::operator delete( block, std::align_val_t( BLOCK_ALIGNMENT ) );
+		}
+		blocks.clear();
+		freeList = nullptr;
+		used = BlockNodes;
+		liveNodes = 0;
+	}
+
+	/// Nodes handed out and not yet freed
+	std::size_t Size() const { return liveNodes; }
+	/// Number of blocks allocated
+	std::size_t BlockCount() const { return blocks.size(); }
+
+private:
+	/**
+	* @brief Allocates a new block and starts handing out from it
+	*/
+	void AddBlock()
+	{
+		Slot* block = static_cast< Slot* >( ::operator new( BlockNodes * sizeof( Slot ), std::align_val_t( BLOCK_ALIGNMENT ) ) );
+		blocks.push_back( block );
+		used = 0;
+	}
+};
+
+
+#endif // !NODEPOOL_HPP
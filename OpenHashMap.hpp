@@ -0,0 +1,240 @@
+#ifndef OPENHASHMAP_HPP
+#define OPENHASHMAP_HPP
+
+
+#include <cstddef>
+#include <cstdint>
+#include <bit>
+#include <functional>
+#include <utility>
+#include <vector>
+
+
+/**
+* @brief Hash map with open addressing and linear probing
+*
+* Every key lives in the slot array itself, a lookup hashes to a slot and
+* walks forward until it finds the key or an empty slot. The table is kept
+* at most half full so those walks stay a slot or two long. Hashes are
+* spread with Fibonacci hashing, so std::hash being the identity for
+* integers doesn't pile sequential keys on top of each other.
+*
+* Erase shifts the following entries back instead of leaving tombstones,
+* so lookups never slow down after lots of removals.
+*
+* @tparam Key Type of the keys
+* @tparam Value Type of the values
+* @tparam Hash Hash of a key
+* @tparam Equal Equality of two keys, must agree with Hash
+*/
+template< typename Key, typename Value, typename Hash = std::hash< Key >, typename Equal = std::equal_to< Key > >
+class OpenHashMap
+{
+private:
+	/**
+	* @brief One slot of the table
+	*/
+	struct Slot
+	{
+		Key key{}; //< Key of the entry
+		Value value{}; //< Value of the entry
+		bool used = false; //< True when the slot holds an entry
+	};
+
+	static constexpr std::size_t MIN_CAPACITY = 16; //< Smallest table we make
+
+	std::vector< Slot > slots; //< The table, a power of two long
+	std::size_t count = 0; //< Entries in the table
+	int shift = 64; //< Drops a spread hash down to a slot index
+	Hash hash; //< Hashes keys
+	Equal equal; //< Compares keys
+
+public:
+	/**
+	* @brief Constructor
+	*
+	* @param capacity Entries to make room for before the first grow
+	*/
+	explicit OpenHashMap( const std::size_t capacity = MIN_CAPACITY )
+	{
+		Rehash( capacity );
+	}
+
+	/// Entries in the map
+	std::size_t Size() const { return count; }
+	/// True when the map has no entries
+	bool Empty() const { return count == 0; }
+
+
+	/**
+	* @brief Finds the value of a key
+	*
+	* @param key The key to search for
+	* @return Pointer to the value, or nullptr if not found, invalid after the next Insert or Erase
+	*/
+	Value* Find( const Key& key )
+	{
+		const std::size_t slot = FindSlot( key );
+		return slot != SIZE_MAX ? &slots[ slot ].value : nullptr;
+	}
+
+	/**
+	* @brief Finds the value of a key
+	*
+	* @param key The key to search for
+	* @return Pointer to the value, or nullptr if not found
+	*/
+	const Value* Find( const Key& key ) const
+	{
+		const std::size_t slot = FindSlot( key );
+		return slot != SIZE_MAX ? &slots[ slot ].value : nullptr;
+	}
+
+	/**
+	* @brief Adds an entry, or replaces the value if the key is already there
+	*
+	* @param key The key
+	* @param value The value
+	* @return Reference to the stored value, invalid after the next Insert or Erase
+	*/
+	Value& Insert( const Key& key, Value value )
+	{
+		if ( ( count + 1 ) * 2 > slots.size() )
+		{
+			Rehash( slots.size() );
+		}
+
+		const std::size_t mask = slots.size() - 1;
+		std::size_t slot = Home( key );
+		while ( slots[ slot ].used )
+		{
+			if ( equal( slots[ slot ].key, key ) )
+			{
+				slots[ slot ].value = std::move( value );
+				return slots[ slot ].value;
+			}
+			slot = ( slot + 1 ) & mask;
+		}
+
+		slots[ slot ].key = key;
+		slots[ slot ].value = std::move( value );
+		slots[ slot ].used = true;
+		++count;
+		return slots[ slot ].value;
+	}
+
+	/**
+	* @brief Removes the entry of a key
+	*
+	* @param key The key to remove
+	* @return true if the key was in the map
+	*/
+	bool Erase( const Key& key )
+	{
+		std::size_t hole = FindSlot( key );
+		if ( hole == SIZE_MAX )
+		{
+			return false;
+		}
+
+		// Pull back every entry after the hole that would
+		// No longer be reachable from its home slot
+		const std::size_t mask = slots.size() - 1;
+		for ( std::size_t next = ( hole + 1 ) & mask; slots[ next ].used; next = ( next + 1 ) & mask )
+		{
+			const std::size_t home = Home( slots[ next ].key );
+			const bool homeInRange = hole <= next ? ( hole < home && home <= next ) : ( hole < home || home <= next );
+			if ( !homeInRange )
+			{
+				slots[ hole ] = std::move( slots[ next ] );
+				hole = next;
+			}
+		}
+
+		slots[ hole ] = Slot{};
+		--count;
+		return true;
+	}
+
+	/**
+	* @brief Removes every entry, the table keeps its size
+	*/
+	void Clear()
+	{
+		std::fill( slots.begin(), slots.end(), Slot{} );
+		count = 0;
+	}
+
+	/**
+	* @brief Makes room for entries without growing again
+	*
+	* @param capacity Entries to make room for
+	*/
+	void Reserve( const std::size_t capacity )
+	{
+		if ( capacity * 2 > slots.size() )
+		{
+			Rehash( capacity );
+		}
+	}
+
+private:
+	/**
+	* @brief Gets the slot a key hashes to
+	*/
+	std::size_t Home( const Key& key ) const
+	{
+		return static_cast< std::size_t >( ( static_cast< std::uint64_t >( hash( key ) ) * 0x9E3779B97F4A7C15ull ) >> shift );
+	}
+
+	/**
+	* @brief Gets the slot holding a key
+	*
+	* @return Index of the slot, or SIZE_MAX if the key isn't there
+	*/
+	std::size_t FindSlot( const Key& key ) const
+	{
+		const std::size_t mask = slots.size() - 1;
+		for ( std::size_t slot = Home( key ); slots[ slot ].used; slot = ( slot + 1 ) & mask )
+		{
+			if ( equal( slots[ slot ].key, key ) )
+			{
+				return slot;
+			}
+		}
+		return SIZE_MAX;
+	}
+
+	/**
+	* @brief Moves every entry into a table big enough for capacity entries
+	*
+	* @param capacity Entries the new table must hold at most half full
+	*/
+	void Rehash( const std::size_t capacity )
+	{
+		const std::size_t size = std::bit_ceil( std::max( capacity * 2, MIN_CAPACITY ) );
+		std::vector< Slot > old = std::exchange( slots, std::vector< Slot >( size ) );
+		shift = 64 - std::countr_zero( size );
+		count = 0;
+
+		const std::size_t mask = size - 1;
+		for ( Slot& entry : old )
+		{
+			if ( !entry.used )
+			{
+				continue;
+			}
+
+			std::size_t slot = Home( entry.key );
+			while ( slots[ slot ].used )
+			{
+				slot = ( slot + 1 ) & mask;
+			}
+			slots[ slot ] = std::move( entry );
+			++count;
+		}
+	}
+};
+
+
+#endif // !OPENHASHMAP_HPP
@@ -0,0 +1,201 @@
+#ifndef PREFIXSUMINDEX_HPP
+#define PREFIXSUMINDEX_HPP
+
+
+#include "ClassBase.hpp"
+#include <span>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <cstdint>
+
+
+/**
+* @brief Index for answering many subarray sum queries on the same data
+*
+* prefix[ j ] is the sum of the first j elements, so the subarray [ i, j )
+* sums to S exactly when prefix[ i ] == prefix[ j ] - S. The prefix sums are
+* built once, and a hash index maps every prefix value to the sorted list of
+* positions it appears at. A query then walks j once, looks the needed
+* prefix up in the hash and binary searches its positions for the latest
+* one before j, O( n log n ) worst case, and unlike the sliding window it
+* doesn't care if values are negative.
+*
+* Integer sums are done in 64 bit unsigned math, which wraps instead of
+* overflowing, and the wrap cancels out when two prefixes are subtracted.
+* Float sums are done in double and compared exactly like SlidingWindow does.
+*
+* @tparam T Numeric type that meets the NumericConstraint requirement
+*/
+template <typename T>
+	requires NumericConstraint<T>
+class PrefixSumIndex
+{
+public:
+	/// Start index and length of a subarray, the same as SlidingWindow returns
+	using Subarray = std::tuple<std::size_t, std::size_t>;
+	/// Type the prefix sums are kept in
+	using PrefixValue = std::conditional_t<std::is_floating_point_v<T>, double, std::uint64_t>;
+
+private:
+	std::vector<PrefixValue> prefix; //< prefix[ j ] is the sum of the first j elements
+	std::vector<std::size_t> positions; //< Every prefix position, grouped by value and sorted within a group
+	std::unordered_map<PrefixValue, std::pair<std::size_t, std::size_t>> groups; //< Prefix value to its offset and count in positions
+
+public:
+	/**
+	* @brief Default constructor, an empty index
+	*/
+	PrefixSumIndex() = default;
+
+	/**
+	* @brief Constructor that builds the index
+	*
+	* @param values Values to index
+	*/
+	explicit PrefixSumIndex( std::span<const T> values )
+	{
+		Build( values );
+	}
+
+	/**
+	* @brief Rebuilds the index, O( n log n )
+	*
+	* @param values Values to index
+	*/
+	void Build( std::span<const T> values )
+	{
+		const std::size_t size = values.size();
+
+		prefix.resize( size + 1 );
+		prefix[ 0 ] = 0;
+		for ( std::size_t i = 0; i < size; ++i )
+		{
+			prefix[ i + 1 ] = prefix[ i ] + ToPrefix( values[ i ] );
+		}
+
+		/// Positions sorted by prefix value, ties stay in index order
+		positions.resize( size + 1 );
+		std::iota( positions.begin(), positions.end(), std::size_t( 0 ) );
+		std::ranges::stable_sort( positions, {}, [ this ]( const std::size_t position ) { return prefix[ position ]; } );
+
+		groups.clear();
+		groups.reserve( size + 1 );
+		for ( std::size_t first = 0; first <= size; )
+		{
+			std::size_t last = first + 1;
+			while ( last <= size && prefix[ positions[ last ] ] == prefix[ positions[ first ] ] )
+			{
+				++last;
+			}
+			groups.emplace( prefix[ positions[ first ] ], std::make_pair( first, last - first ) );
+			first = last;
+		}
+	}
+
+	/**
+	* @brief Gets the number of indexed values
+	*
+	* @return Number of values
+	*/
+	std::size_t Size() const
+	{
+		return prefix.empty() ? 0 : prefix.size() - 1;
+	}
+
+	/**
+	* @brief Gets the sum of a subarray in O( 1 )
+	*
+	* @param start First index of the subarray
+	* @param length Number of elements
+	* @return Sum of the subarray, as the 64 bit or double the index keeps
+	*/
+	PrefixValue RangeSum( const std::size_t start, const std::size_t length ) const
+	{
+		return prefix[ start + length ] - prefix[ start ];
+	}
+
+	/**
+	* @brief Finds a non empty subarray that sums to target
+	*
+	* Of all the matches, this gives the one that ends first,
+	* and the shortest of those. O( n log n ) worst case
+	*
+	* @param target Sum to look for
+	* @return std::nullopt if there is none, else the start index and length
+	*/
+	std::optional<Subarray> FindSubarray( const T target ) const
+	{
+		const PrefixValue wanted = ToPrefix( target );
+		for ( std::size_t end = 1; end < prefix.size(); ++end )
+		{
+			const auto match = MatchEndingAt( end, wanted );
+			if ( match.has_value() )
+			{
+				return match;
+			}
+		}
+		return std::nullopt;
+	}
+
+	/**
+	* @brief Answers a batch of queries against the same index
+	*
+	* Each query walks the prefix sums on its own and stops at its first
+	* match. Interleaving the queries doesn't help here, the prefix sums
+	* are read in order either way and the hash probes are what cost.
+	*
+	* @param targets Sums to look for
+	* @param results Receives the answer for each target, must be at least targets.size()
+	*/
+	void FindSubarrays( std::span<const T> targets, std::span<std::optional<Subarray>> results ) const
+	{
+		for ( std::size_t i = 0; i < targets.size(); ++i )
+		{
+			results[ i ] = FindSubarray( targets[ i ] );
+		}
+	}
+
+	/**
+	* @brief Converts a value to the type the prefix sums are kept in
+	*
+	* @param value Value to convert
+	* @return The value, negative integers wrap around
+	*/
+	static PrefixValue ToPrefix( const T value )
+	{
+		return static_cast< PrefixValue >( value );
+	}
+
+private:
+	/**
+	* @brief Looks for a subarray that ends just before end and sums to wanted
+	*
+	* @param end One past the last index of the subarray
+	* @param wanted Sum to look for
+	* @return std::nullopt if there is none, else the shortest one
+	*/
+	std::optional<Subarray> MatchEndingAt( const std::size_t end, const PrefixValue wanted ) const
+	{
+		const auto group = groups.find( prefix[ end ] - wanted );
+		if ( group == groups.end() )
+		{
+			return std::nullopt;
+		}
+
+		/// Latest position before end, positions in a group are in order
+		const auto first = positions.begin() + group->second.first;
+		const auto last = first + group->second.second;
+		const auto after = std::lower_bound( first, last, end );
+		if ( after == first )
+		{
+			return std::nullopt;
+		}
+
+		const std::size_t start = *( after - 1 );
+		return std::make_tuple( start, end - start );
+	}
+};
+
+
+#endif // !PREFIXSUMINDEX_HPP
@@ -0,0 +1,390 @@
+#ifndef SEARCHCORES_HPP
+#define SEARCHCORES_HPP
+
+
+#include "ClassBase.hpp"
+#include "VectorSearch.hpp"
+#include "StreamingWindow.hpp"
+#include "ThreadPool.hpp"
+#include <span>
+#include <tuple>
+#include <optional>
+#include <atomic>
+#include <type_traits>
+
+
+/**
+* @brief The searches from SearchAlogrithms as free functions over a span
+*
+* Nothing here prints, times or allocates, results go into buffers the
+* caller passes in. The searches that need sorted data say so, they don't
+* check. SearchAlogrithms wraps these for its demos and benchmarks.
+*
+* The data parameter doesn't take part in deducing T, so a span<T> or a
+* vector<T> can be passed straight in where T comes from the value.
+*/
+namespace SearchCores
+{
+	/// Start index and length of a subarray
+	using Subarray = std::tuple<std::size_t, std::size_t>;
+
+	/// Span of the data being searched, not used to deduce T
+	template <typename T>
+	using Data = std::span<const std::type_identity_t<T>>;
+
+	/// Keys a batched search walks down the array together
+	inline constexpr std::size_t SEARCH_BATCH_SIZE = 16;
+	/// Arrays smaller than this many elements per chunk aren't worth splitting
+	inline constexpr std::size_t PARALLEL_SCAN_GRAIN = 1 << 16;
+	/// Elements a chunk scans between checks for a hit in a lower chunk
+	inline constexpr std::size_t PARALLEL_SCAN_BLOCK = 1 << 14;
+
+	///--------------Linear-Scans--------------///
+
+	/**
+	* @brief Linear search, vectorized when T has a kernel, see VectorSearch
+	*
+	* @param data Elements to search, in any order
+	* @param value Value to search for
+	* @return Index of the first match, or SIZE_MAX if not found
+	*/
+	template <typename T>
+	std::size_t LinearSearch( Data<T> data, const T value )
+	{
+		return VectorSearch::FindFirst( data.data(), data.size(), value );
+	}
+
+	/**
+	* @brief Counts the elements equal to value
+	*
+	* @param data Elements to search, in any order
+	* @param value Value to count
+	* @return Number of matches
+	*/
+	template <typename T>
+	std::size_t CountMatches( Data<T> data, const T value )
+	{
+		return VectorSearch::Count( data.data(), data.size(), value );
+	}
+
+	/**
+	* @brief Finds every element equal to value
+	*
+	* @param data Elements to search, in any order
+	* @param value Value to search for
+	* @param matches Receives the first matches.size() matching indexes, in order
+	* @return Total number of matches, more than matches.size() if some didn't fit
+	*/
+	template <typename T>
+	std::size_t FindAllMatches( Data<T> data, const T value, std::span<std::size_t> matches )
+	{
+		return VectorSearch::FindAll( data.data(), data.size(), value, matches );
+	}
+
+	/**
+	* @brief Scans one chunk for the parallel find, see ParallelFindFirst
+	*
+	* @param data Elements to search
+	* @param value Value to search for
+	* @param start First index of the chunk
+	* @param end One past the last index of the chunk
+	* @param found Lowest hit so far from any chunk
+	*/
+	template <typename T>
+	void ScanChunk( Data<T> data, const T value, std::size_t start, const std::size_t end, std::atomic<std::size_t>& found )
+	{
+		while ( start < end )
+		{
+			/// A lower chunk has a hit, nothing from here on can beat it
+			if ( found.load( std::memory_order_relaxed ) < start )
+			{
+				return;
+			}
+
+			const std::size_t blockEnd = std::min( start + PARALLEL_SCAN_BLOCK, end );
+			const std::size_t hit = VectorSearch::FindFirst( data.data() + start, blockEnd - start, value );
+			if ( hit != SIZE_MAX )
+			{
+				/// Keep the lowest, another chunk may have beaten us to it
+				const std::size_t index = start + hit;
+				std::size_t current = found.load();
+				while ( index < current && !found.compare_exchange_weak( current, index ) )
+				{
+				}
+				return;
+			}
+			start = blockEnd;
+		}
+	}
+
+	/**
+	* @brief Linear search split across the pool, for arrays too big
+	* for one core's memory bandwidth
+	*
+	* The array is cut into chunks in index order. Each chunk scans in blocks
+	* of PARALLEL_SCAN_BLOCK and gives up as soon as a lower chunk has found
+	* a hit, since nothing past that can be the answer. Chunks keep the
+	* lowest hit in an atomic, so the result is the same as LinearSearch.
+	*
+	* @param data Elements to search, in any order
+	* @param value Value to search for
+	* @param pool Pool to scan on
+	* @return Index of the first match, or SIZE_MAX if not found
+	*/
+	template <typename T>
+	std::size_t ParallelFindFirst( Data<T> data, const T value, ThreadPool& pool )
+	{
+		const std::size_t size = data.size();
+		const std::size_t chunks = std::clamp< std::size_t >( size / PARALLEL_SCAN_GRAIN, 1, pool.GetThreadCount() * 4 );
+		if ( chunks == 1 )
+		{
+			return LinearSearch( data, value );
+		}
+
+		std::atomic<std::size_t> found = SIZE_MAX;
+		TaskGroup group( pool );
+		for ( std::size_t c = 0; c < chunks; ++c )
+		{
+			const std::size_t start = size * c / chunks;
+			const std::size_t end = size * ( c + 1 ) / chunks;
+			group.Run( [ data, &found, value, start, end ]() { ScanChunk<T>( data, value, start, end, found ); } );
+		}
+		group.Wait();
+
+		return found.load();
+	}
+
+	///--------------Sorted-Searches--------------///
+
+	/**
+	* @brief Shared loop of LowerBound and UpperBound
+	*
+	* base always points at the start of the range that holds the answer,
+	* each step keeps the upper half if goRight says the answer is past
+	* the midpoint. The ternary compiles to a cmov.
+	*
+	* @param data Sorted elements
+	* @param value Value to search for
+	* @param goRight Returns true when the answer is after element
+	* @return Index of the first element goRight is false for
+	*/
+	template <typename T, typename GoRight>
+	std::size_t BranchlessBound( Data<T> data, const T value, GoRight goRight )
+	{
+		if ( data.empty() )
+		{
+			return 0;
+		}
+
+		const T* base = data.data();
+		std::size_t size = data.size();
+
+		while ( size > 1 )
+		{
+			const std::size_t half = size / 2;
+			const std::size_t nextHalf = ( size - half ) / 2;
+
+			/// We don't know which way we go yet, so fetch both
+			Prefetch( base + nextHalf );
+			Prefetch( base + half + nextHalf );
+
+			base = goRight( base[ half ], value ) ? base + half : base;
+			size -= half;
+		}
+
+		return ( base - data.data() ) + goRight( *base, value );
+	}
+
+	/**
+	* @brief Branchless lower bound
+	*
+	* Every step halves the range with a conditional move instead of a
+	* branch, so there is nothing to mispredict and the loop always runs
+	* log2( n ) times. Both possible next midpoints are prefetched
+	* while we wait on the current compare.
+	*
+	* @param data Sorted elements
+	* @param value Value to search for
+	* @return Index of the first element not less than value, or data.size() if there is none
+	*/
+	template <typename T>
+	std::size_t LowerBound( Data<T> data, const T value )
+	{
+		return BranchlessBound( data, value, []( const T& element, const T& key ) { return element < key; } );
+	}
+
+	/**
+	* @brief Branchless upper bound, see LowerBound
+	*
+	* @param data Sorted elements
+	* @param value Value to search for
+	* @return Index of the first element greater than value, or data.size() if there is none
+	*/
+	template <typename T>
+	std::size_t UpperBound( Data<T> data, const T value )
+	{
+		return BranchlessBound( data, value, []( const T& element, const T& key ) { return !( key < element ); } );
+	}
+
+	/**
+	* @brief Binary search for an exact match
+	*
+	* @param data Sorted elements
+	* @param value Value to search for
+	* @return Index of the first match, or SIZE_MAX if not found
+	*/
+	template <typename T>
+	std::size_t BinarySearch( Data<T> data, const T value )
+	{
+		const std::size_t index = LowerBound( data, value );
+
+		if ( index < data.size() && data[ index ] == value )
+		{
+			return index;
+		}
+		return SIZE_MAX;
+	}
+
+	/**
+	* @brief Lower bound for many keys at once
+	*
+	* Keys are searched in groups of SEARCH_BATCH_SIZE that step down the
+	* array together. Each key's probe doesn't depend on the others, so
+	* their cache misses overlap instead of being paid one after the other.
+	*
+	* @param data Sorted elements
+	* @param keys Values to search for
+	* @param results Receives the lower bound of each key, must be at least keys.size()
+	*/
+	template <typename T>
+	void LowerBoundBatch( Data<T> data, std::span<const T> keys, std::span<std::size_t> results )
+	{
+		const T* bases[ SEARCH_BATCH_SIZE ];
+
+		for ( std::size_t first = 0; first < keys.size(); first += SEARCH_BATCH_SIZE )
+		{
+			const std::size_t count = std::min( SEARCH_BATCH_SIZE, keys.size() - first );
+			const T* batch = keys.data() + first;
+
+			if ( data.empty() )
+			{
+				std::fill_n( results.begin() + first, count, 0 );
+				continue;
+			}
+
+			std::fill_n( bases, count, data.data() );
+
+			/// Every key in the group has the same range size at each step
+			std::size_t size = data.size();
+			while ( size > 1 )
+			{
+				const std::size_t half = size / 2;
+				const std::size_t nextHalf = ( size - half ) / 2;
+
+				for ( std::size_t k = 0; k < count; ++k )
+				{
+					bases[ k ] = bases[ k ][ half ] < batch[ k ] ? bases[ k ] + half : bases[ k ];
+					/// We know which way this key went, prefetch its next probe
+					Prefetch( bases[ k ] + nextHalf );
+				}
+				size -= half;
+			}
+
+			for ( std::size_t k = 0; k < count; ++k )
+			{
+				results[ first + k ] = ( bases[ k ] - data.data() ) + ( *bases[ k ] < batch[ k ] );
+			}
+		}
+	}
+
+	///--------------Subarray-Sums--------------///
+
+	/**
+	* @brief Sliding window search for a subarray that sums to target
+	*
+	* The window grows while the sum is under target and shrinks from the
+	* left while it is over, or longer than maxLength. Only works when
+	* every value is non negative.
+	*
+	* @param data Elements to search
+	* @param target Sum to look for
+	* @param maxLength Longest window to consider
+	* @return std::nullopt if not found, else the start index and length
+	*/
+	template <typename T>
+	std::optional<Subarray> SlidingWindow( Data<T> data, const T target, const std::size_t maxLength )
+	{
+		if ( data.empty() )
+		{
+			return std::nullopt;
+		}
+
+		/// Our pointer window
+		std::size_t pLower = 0;
+		std::size_t pUpper = 0;
+
+		/// The current sum of the window
+		T cSum = data[ 0 ];
+
+		/// Loop through array looking for subarray
+		while ( cSum != target && pUpper < data.size() )
+		{
+			if ( cSum > target || pUpper - pLower > maxLength )
+			{
+				cSum -= data[ pLower ];
+				++pLower;
+			} else if ( ++pUpper < data.size() )
+			{
+				cSum += data[ pUpper ];
+			}
+		}
+
+		if ( cSum == target )
+		{
+			return std::make_tuple( pLower, pUpper - pLower + 1 );
+		}
+		return std::nullopt;
+	}
+
+	/**
+	* @brief Finds the first window of exactly length elements that sums to target
+	*
+	* The same search the streaming window does, but with the whole array
+	* at hand the element leaving the window is just read back, so there is
+	* no ring buffer. Sums are kept wide like StreamingWindow does.
+	*
+	* @param data Elements to search, negative values are fine
+	* @param target Sum to look for
+	* @param length Number of elements in the window, more than 0
+	* @return std::nullopt if not found, else the start index and length
+	*/
+	template <typename T>
+	std::optional<Subarray> FixedWindowSum( Data<T> data, const T target, const std::size_t length )
+	{
+		using SumType = typename StreamingWindow<T>::SumType;
+		if ( length == 0 || length > data.size() )
+		{
+			return std::nullopt;
+		}
+
+		const SumType wanted = static_cast< SumType >( target );
+		SumType sum = 0;
+		for ( std::size_t i = 0; i < data.size(); ++i )
+		{
+			/// Oldest out before newest in, the same order StreamingWindow sums in
+			if ( i >= length )
+			{
+				sum -= static_cast< SumType >( data[ i - length ] );
+			}
+			sum += static_cast< SumType >( data[ i ] );
+			if ( i + 1 >= length && sum == wanted )
+			{
+				return std::make_tuple( i + 1 - length, length );
+			}
+		}
+		return std::nullopt;
+	}
+}
+
+
+#endif // !SEARCHCORES_HPP
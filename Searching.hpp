@@ -1,5 +1,14 @@
 #include "ClassBase.hpp"
+#include "EytzingerIndex.hpp"
+#include "VectorSearch.hpp"
+#include "PrefixSumIndex.hpp"
+#include "StreamingWindow.hpp"
+#include "ThreadPool.hpp"
+#include "SortCores.hpp"
+#include "SearchCores.hpp"
 #include <array>
+#include <ostream>
+#include <span>
 
 
 
@@ -22,6 +31,9 @@
 *
 * We are also just returning array indexes for the result; as to use for 
 * checking if we got the correct result
+*
+* The searches themselves live in SearchCores and work on any span, this
+* class runs them on its own array and adds the printing and timing.
 */
 template <typename T>
 	requires NumericConstraint<T>
@@ -32,6 +44,19 @@ private:
 	T sSumValue; //< sum of sub array
 	std::size_t sSumStart; //< starting index of sub array
 	std::size_t sSumLen; //< length of sub array
+	std::vector<T> batchKeys; //< keys for the batched binary search benchmark
+	std::vector<std::size_t> batchResults; //< results of the batched binary search benchmark
+	EytzingerIndex<T> searchIndex; //< Eytzinger copy of the sorted array
+	std::vector<std::size_t> matchBuffer; //< reused by the find all matches benchmark
+	std::unique_ptr<ThreadPool> pool; //< Pool for the parallel scan, made on first use
+	PrefixSumIndex<T> sumIndex; //< Prefix sums and their hash index for subarray sum queries
+	std::vector<T> batchSums; //< targets for the batched subarray sum benchmark
+	std::vector<std::optional<std::tuple<std::size_t, std::size_t>>> batchSumResults; //< results of the batched subarray sum benchmark
+
+	/// Number of keys the batched search benchmarks look up per run
+	static constexpr std::size_t SEARCH_BENCH_KEYS = 1024;
+	/// Number of subarray sums the batched sum benchmark looks up per run
+	static constexpr std::size_t SUM_BENCH_QUERIES = 32;
 
 public:
 
@@ -54,7 +79,7 @@ public:
 	void TestAllSearchAlgorithms()
 	{
 		auto lSResult = LinearSearch();
-		if ( lSResult.has_value() && this->array[ lSResult.value() ] == sValues[ 1 ] )
+		if ( lSResult.has_value() && this->view[ lSResult.value() ] == sValues[ 1 ] )
 		{
 			PrintResults( lSResult.value() );
 		}
@@ -63,11 +88,372 @@ public:
 		{
 			SWPrintResults( sWResult.value() );
 		}
+		auto sSResult = StreamingWindowSearch();
+		if ( sSResult.has_value() && SubarraySum( sSResult.value() ) == sSumValue )
+		{
+			SWPrintResults( sSResult.value() );
+		}
+		auto pSResult = PrefixSumSearch();
+		if ( pSResult.has_value() && SubarraySum( pSResult.value() ) == sSumValue )
+		{
+			SWPrintResults( pSResult.value() );
+		}
 		auto bSResult = BinarySearch();
-		if ( bSResult.has_value() && this->array[ bSResult.value() ] == sValues[ 0 ] )
+		if ( bSResult.has_value() && this->view[ bSResult.value() ] == sValues[ 0 ] )
 		{
 			PrintResults( bSResult.value() );
 		}
+		auto iSResult = IndexSearch();
+		if ( iSResult.has_value() && this->view[ iSResult.value() ] == sValues[ 0 ] )
+		{
+			PrintResults( iSResult.value() );
+		}
+	}
+
+	/**
+	* @brief Benchmarks all search algorithms with repeated runs
+	*
+	* The searches don't modify the array, so there is
+	* no setup between runs
+	*
+	* @param runs Number of timed runs per algorithm
+	* @param warmup Number of untimed warmup runs per algorithm
+	*/
+	void BenchmarkAllSearchAlgorithms( const std::size_t runs = 101, const std::size_t warmup = 10 )
+	{
+		BenchmarkRunner runner( warmup, runs );
+
+		const auto Bench = [ & ]( const std::string& name, auto&& search )
+		{
+			const BenchStats stats = runner.Run( this->szArray, []() {}, [ & ]()
+			{
+				DoNotOptimize( search() );
+			} );
+			BenchmarkRunner::PrintStats( name, stats );
+		};
+
+		Bench( "Linear Search", [ & ]() { return LinearSearchCore(); } );
+		Bench( "Count Matches", [ & ]() { return CountMatches( sValues[ 1 ] ); } );
+		Bench( "Find All Matches", [ & ]()
+		{
+			matchBuffer.clear();
+			FindAllMatches( sValues[ 1 ], matchBuffer );
+			return matchBuffer.size();
+		} );
+		Bench( "Binary Search", [ & ]() { return BinarySearchCore(); } );
+		Bench( "Eytzinger Search", [ & ]() { return IndexSearchCore(); } );
+		Bench( "Sliding Window Search", [ & ]() { return SlidingWindowCore(); } );
+		Bench( "Streaming Window Search", [ & ]() { return StreamingWindowCore(); } );
+		Bench( "Prefix Sum Search", [ & ]() { return PrefixSumSearchCore(); } );
+		Bench( "Batched Prefix Sum Search", [ & ]()
+		{
+			FindSubarraySums( batchSums, batchSumResults );
+			return batchSumResults.size();
+		} );
+		BenchBatchedSearch( runner, []( const std::string_view name, const BenchStats& stats )
+		{
+			BenchmarkRunner::PrintStats( std::string( name ), stats );
+		} );
+	}
+
+	/**
+	* @brief Runs every search over every input distribution
+	* and prints the results as CSV
+	*
+	* Linear search runs on the generated data as is, the array is
+	* then merge sorted for binary and sliding window search. New search
+	* values are picked each time, so the class is left on valid data.
+	*
+	* @param size Number of elements in each array, minimum of 21
+	* @param out Stream to write the CSV to
+	* @param runs Number of timed runs per search
+	* @param warmup Number of untimed warmup runs per search
+	*/
+	void BenchmarkAllDistributions( const std::size_t size = 1'000'000, std::ostream& out = std::cout,
+									const std::size_t runs = 101, const std::size_t warmup = 10 )
+	{
+		const Distribution oldDistribution = this->GetDistribution();
+		BenchmarkRunner runner( warmup, runs );
+
+		const auto Bench = [ & ]( const Distribution dist, const std::string_view name, auto&& search )
+		{
+			const BenchStats stats = runner.Run( this->szArray, []() {}, [ & ]()
+			{
+				DoNotOptimize( search() );
+			} );
+			BenchmarkRunner::PrintCsvRow( out, GetDistributionName( dist ), name, stats );
+		};
+
+		BenchmarkRunner::PrintCsvHeader( out );
+		for ( const Distribution dist : allDistributions )
+		{
+			this->SetDistribution( dist );
+			this->InitArray( std::max< std::size_t >( size, 21 ) );
+
+			InitSearchValues();
+			Bench( dist, "Linear Search", [ & ]() { return LinearSearchCore(); } );
+			Bench( dist, "Count Matches", [ & ]() { return CountMatches( sValues[ 1 ] ); } );
+			Bench( dist, "Find All Matches", [ & ]()
+			{
+				matchBuffer.clear();
+				FindAllMatches( sValues[ 1 ], matchBuffer );
+				return matchBuffer.size();
+			} );
+
+			this->tempBuffer.resize( this->szArray );
+			SortCores::MergeSort( this->view, std::span<T>( this->tempBuffer ) );
+			searchIndex.Build( this->view );
+			sumIndex.Build( this->view );
+
+			InitSearchValues();
+			Bench( dist, "Binary Search", [ & ]() { return BinarySearchCore(); } );
+			Bench( dist, "Eytzinger Search", [ & ]() { return IndexSearchCore(); } );
+			Bench( dist, "Sliding Window Search", [ & ]() { return SlidingWindowCore(); } );
+			Bench( dist, "Streaming Window Search", [ & ]() { return StreamingWindowCore(); } );
+			Bench( dist, "Prefix Sum Search", [ & ]() { return PrefixSumSearchCore(); } );
+			BenchBatchedSearch( runner, [ & ]( const std::string_view name, const BenchStats& stats )
+			{
+				BenchmarkRunner::PrintCsvRow( out, GetDistributionName( dist ), name, stats );
+			} );
+		}
+		this->SetDistribution( oldDistribution );
+	}
+
+	/**
+	* @brief Compares binary search on the sorted array against the
+	* Eytzinger index as the array grows, printed as CSV
+	*
+	* Sizes go up 4x at a time. Each size times SEARCH_BENCH_KEYS random
+	* lookups, so the ns per lookup column is what to compare.
+	*
+	* @note The index is a second copy of the array padded to a full
+	* tree, so the biggest size needs up to 3x its size in memory
+	*
+	* @param minSize Smallest array
+	* @param maxSize Biggest array
+	* @param out Stream to write the CSV to
+	* @param runs Number of timed runs per search and size
+	* @param warmup Number of untimed warmup runs per search and size
+	*/
+	void BenchmarkSearchIndexSweep( const std::size_t minSize = std::size_t( 1 ) << 10, const std::size_t maxSize = std::size_t( 1 ) << 30,
+									std::ostream& out = std::cout, const std::size_t runs = 11, const std::size_t warmup = 2 )
+	{
+		const Distribution oldDistribution = this->GetDistribution();
+		BenchmarkRunner runner( warmup, runs );
+
+		std::println( out, "size,algorithm,median_us,ns_per_lookup" );
+		const auto Report = [ & ]( const std::string_view name, const BenchStats& stats )
+		{
+			std::println( out, "{},{},{:.3f},{:.3f}", this->szArray, name, stats.medianUs, stats.medianUs * 1000.0 / stats.elements );
+		};
+
+		/// Sorted data straight from the generator, sorting a billion elements with merge sort takes a while
+		this->SetDistribution( Distribution::Sorted );
+		for ( std::size_t size = std::max< std::size_t >( minSize, 21 ); size <= maxSize; size *= 4 )
+		{
+			this->InitArray( size );
+			searchIndex.Build( this->view );
+			InitSearchValues();
+
+			BenchBatchedSearch( runner, Report );
+		}
+
+		this->SetDistribution( oldDistribution );
+		InitData();
+	}
+
+	/**
+	* @brief Uses a binary file of T as the search data, see AlgorithmsBase::LoadArray
+	*
+	* The file is mapped copy on write and merge sorted in place if it isn't
+	* sorted already, the sorted pages stay private to us and the file is not
+	* changed. The indexes and search values are then rebuilt from it, and the
+	* mapping is switched to random access for the binary searches.
+	*
+	* @param path File of raw T values, at least 21 of them
+	* @throws std::runtime_error If the file can't be mapped or is too small,
+	* the class goes back to generated data
+	*/
+	void LoadSearchData( const std::filesystem::path& path )
+	{
+		try
+		{
+			this->LoadArray( path, MapMode::CopyOnWrite, AccessHint::Sequential );
+			if ( this->szArray < 21 )
+			{
+				throw std::runtime_error( "Failed to load " + path.string() + ", search data needs at least 21 values.\n" );
+			}
+		} catch ( ... )
+		{
+			InitData();
+			throw;
+		}
+
+		if ( !std::is_sorted( this->view.begin(), this->view.end() ) )
+		{
+			this->tempBuffer.resize( this->szArray );
+			SortCores::MergeSort( this->view, std::span<T>( this->tempBuffer ) );
+		}
+		searchIndex.Build( this->view );
+		sumIndex.Build( this->view );
+		InitSearchValues();
+
+		this->AdviseArray( AccessHint::Random );
+	}
+
+	/**
+	* @brief Finds a subarray for each target sum through the prefix sum index
+	*
+	* Works with negative values and any subarray length, unlike SlidingWindow.
+	* Each target is looked up separately against the shared index,
+	* O( n log n ) worst case per target.
+	*
+	* @param targets Sums to look for
+	* @param results Receives std::nullopt or the start index and length
+	* for each target, must be at least targets.size()
+	*/
+	void FindSubarraySums( std::span<const T> targets, std::span<std::optional<std::tuple<std::size_t, std::size_t>>> results ) const
+	{
+		sumIndex.FindSubarrays( targets, results );
+	}
+
+	/**
+	* @brief Sets the number of threads the parallel scan uses
+	*
+	* @param threads Number of worker threads
+	*/
+	void SetThreadCount( const std::size_t threads )
+	{
+		pool = std::make_unique<ThreadPool>( threads );
+	}
+
+	/**
+	* @brief Linear search split across the pool, for arrays too big
+	* for one core's memory bandwidth
+	*
+	* See SearchCores::ParallelFindFirst, uses the pool from
+	* SetThreadCount, or one thread per core
+	*
+	* @param value Value to search for
+	* @return Index of the first match, or SIZE_MAX if not found
+	*/
+	std::size_t ParallelFindFirst( const T value )
+	{
+		if ( !pool )
+		{
+			pool = std::make_unique<ThreadPool>();
+		}
+		return SearchCores::ParallelFindFirst( this->view, value, *pool );
+	}
+
+	/**
+	* @brief Benchmarks the parallel scan at 1, 2, 4 ... threads up to the
+	* core count and prints the bandwidth it gets as CSV
+	*
+	* The scan looks for a value that isn't there, so every byte is read.
+	* Its GB/s is compared against a plain read of the same array on the same
+	* threads, which is as close to the machine's stream bandwidth as a scan
+	* can get. The hit column looks for the middle element, where chunks past
+	* the first hit give up early.
+	*
+	* @param size Number of elements to scan, the default is 1GB of 4 byte T
+	* @param out Stream to write the CSV to
+	* @param runs Number of timed runs per thread count
+	* @param warmup Number of untimed warmup runs per thread count
+	*/
+	void BenchmarkParallelScan( const std::size_t size = std::size_t( 1 ) << 28, std::ostream& out = std::cout,
+								const std::size_t runs = 5, const std::size_t warmup = 1 )
+	{
+		this->InitArray( std::max< std::size_t >( size, 21 ) );
+		const double gigabytes = static_cast< double >( this->szArray * sizeof( T ) ) / 1e9;
+
+		/// Values are never negative, so this is a miss, for unsigned the max is past anything generated
+		const T missValue = std::is_signed_v<T> ? T( -1 ) : ( std::numeric_limits<T>::max )();
+		const T hitValue = this->view[ this->szArray / 2 ];
+
+		/// 1, 2, 4 ... and the core count itself if that isn't a power of two
+		const std::size_t maxThreads = std::max< std::size_t >( std::thread::hardware_concurrency(), 1 );
+		std::vector<std::size_t> threadCounts;
+		for ( std::size_t threads = 1; threads < maxThreads; threads *= 2 )
+		{
+			threadCounts.push_back( threads );
+		}
+		threadCounts.push_back( maxThreads );
+
+		BenchmarkRunner runner( warmup, runs );
+		std::println( out, "threads,size,scan_median_us,scan_gb_s,stream_gb_s,percent_of_stream,hit_median_us" );
+		for ( const std::size_t threads : threadCounts )
+		{
+			SetThreadCount( threads );
+
+			const BenchStats stream = runner.Run( this->szArray, []() {}, [ & ]() { DoNotOptimize( StreamRead() ); } );
+			const BenchStats miss = runner.Run( this->szArray, []() {}, [ & ]() { DoNotOptimize( ParallelFindFirst( missValue ) ); } );
+			const BenchStats hit = runner.Run( this->szArray, []() {}, [ & ]() { DoNotOptimize( ParallelFindFirst( hitValue ) ); } );
+
+			const double scanRate = gigabytes / ( miss.medianUs / 1e6 );
+			const double streamRate = gigabytes / ( stream.medianUs / 1e6 );
+			std::println( out, "{},{},{:.3f},{:.3f},{:.3f},{:.1f},{:.3f}", threads, this->szArray, miss.medianUs,
+						  scanRate, streamRate, scanRate / streamRate * 100.0, hit.medianUs );
+		}
+
+		/// Back to one thread per core, and the usual sorted data
+		pool.reset();
+		InitData();
+	}
+
+	/**
+	* @brief Counts the elements equal to value, the array doesn't need to be sorted
+	*
+	* @param value Value to count
+	* @return Number of matches
+	*/
+	std::size_t CountMatches( const T value ) const
+	{
+		return SearchCores::CountMatches( this->view, value );
+	}
+
+	/**
+	* @brief Finds every element equal to value, the array doesn't need to be sorted
+	*
+	* @param value Value to search for
+	* @param matches Indexes of the matches are appended here, in order
+	*/
+	void FindAllMatches( const T value, std::vector<std::size_t>& matches ) const
+	{
+		VectorSearch::FindAll( this->view.data(), this->szArray, value, matches );
+	}
+
+	/**
+	* @brief Branchless lower bound on the sorted array, see SearchCores::LowerBound
+	*
+	* @param value Value to search for
+	* @return Index of the first element not less than value, or szArray if there is none
+	*/
+	std::size_t LowerBound( const T value ) const
+	{
+		return SearchCores::LowerBound( this->view, value );
+	}
+
+	/**
+	* @brief Branchless upper bound on the sorted array, see LowerBound
+	*
+	* @param value Value to search for
+	* @return Index of the first element greater than value, or szArray if there is none
+	*/
+	std::size_t UpperBound( const T value ) const
+	{
+		return SearchCores::UpperBound( this->view, value );
+	}
+
+	/**
+	* @brief Lower bound for many keys at once, see SearchCores::LowerBoundBatch
+	*
+	* @param keys Values to search for
+	* @param results Receives the lower bound of each key, must be at least keys.size()
+	*/
+	void LowerBoundBatch( std::span<const T> keys, std::span<std::size_t> results ) const
+	{
+		SearchCores::LowerBoundBatch<T>( this->view, keys, results );
 	}
 
 private:
@@ -82,20 +468,11 @@ private:
 		// Print algorithm name
 		this->PrintAlgoName( "Linear Search" );
 
-		/// our result for search
-		std::size_t result = SIZE_MAX;
-
 		/// Start Timer
 		this->timer.Start();
 
-		for ( int i = 0; i < this->szArray; ++i )
-		{
-			if ( this->array[ i ] == sValues[ 1 ] )
-			{
-				result = i;
-				break;
-			}
-		}
+		/// our result for search
+		const std::size_t result = LinearSearchCore();
 
 		// End Timer
 		this->timer.Stop();
@@ -120,36 +497,11 @@ private:
 		// Print algorithm name
 		this->PrintAlgoName( "Binary Search" );
 
-		/// our result for search
-		std::size_t result = SIZE_MAX;
-
 		/// Start Timer
 		this->timer.Start();
 
-		/// Our pointer window
-		std::size_t pLower = 0;
-		std::size_t pUpper = this->szArray - 1;
-
-		/// Calculate the middle point 
-		std::size_t mid = std::midpoint( pLower, pUpper );
-
-		/// Loop through array searching for value
-		while ( pLower < pUpper || pUpper - pLower == 1 )
-		{
-			if ( this->array[ mid ] == sValues[ 0 ] )
-			{
-				result = mid;
-				break;
-			} else if ( sValues[ 0 ] > this->array[ mid ] )
-			{
-				pLower = mid + 1;
-				mid = std::midpoint( pLower, pUpper );
-			} else if ( sValues[ 0 ] < this->array[ mid ] )
-			{
-				pUpper = mid - 1;
-				mid = std::midpoint( pLower, pUpper );
-			}
-		}
+		/// our result for search
+		const std::size_t result = BinarySearchCore();
 
 		// End Timer
 		this->timer.Stop();
@@ -182,120 +534,287 @@ private:
 		/// Start Timer
 		this->timer.Start();
 
-		/// Our pointer window
-		std::size_t pLower = 0;
-		std::size_t pUpper = 0;
+		/// our result for search
+		const auto result = SlidingWindowCore();
 
-		/// The current sum of the window
-		T cSum = this->array[ 0 ];
+		// End Timer
+		this->timer.Stop();
 
-		/// Loop through array looking for subarray
-		while ( cSum != sSumValue && pUpper < this->szArray )
+		if ( !result.has_value() )
 		{
-			if ( cSum > sSumValue || pUpper - pLower > sSumLen )
-			{
-				cSum -= this->array[ pLower ];
-				++pLower;
-			} else
-			{
-				cSum += this->array[ ++pUpper ];
-			}
+			std::cout << "Failed To Find Sub Array In Data\n";
 		}
+		return result;
+	}
+
+
+	/**
+	* @brief Binary search through the Eytzinger index
+	*
+	* @return std::nullopt if not found, else index of value to search for
+	*/
+	std::optional<std::size_t> IndexSearch()
+	{
+		// Print algorithm name
+		this->PrintAlgoName( "Eytzinger Search" );
+
+		/// Start Timer
+		this->timer.Start();
+
+		/// our result for search
+		const std::size_t result = IndexSearchCore();
 
 		// End Timer
 		this->timer.Stop();
 
-		if ( cSum == sSumValue )
+		if ( result != SIZE_MAX )
 		{
-			return std::make_tuple( pLower, pUpper - pLower + 1 );
+			return result;
 		} else
 		{
-			std::cout << "Failed To Find Sub Array In Data\n";
+			std::cout << "Failed To Find Value In Data\n";
 			return std::nullopt;
 		}
 	}
 
-	///---------------Merge-Sort-Start---------------///
 
 	/**
-	* @brief Initializes and executes the Merge Sort algorithm
+	* @brief Sliding window search with the array fed in as a stream
+	*
+	* @return std::nullopt if not found, or a tuple where the first value is the
+	*         0th index of the subarray and the second is the length of the subarray
 	*/
-	void MergeSortInit()
+	std::optional<std::tuple<std::size_t, std::size_t>> StreamingWindowSearch()
 	{
-		this->InitArray();
-		// Edge case check
-		if ( this->szArray == 0 || this->szArray == 1 )
+		// Print algorithm name
+		this->PrintAlgoName( "Streaming Window Search" );
+
+		/// Start Timer
+		this->timer.Start();
+
+		/// our result for search
+		const auto result = StreamingWindowCore();
+
+		// End Timer
+		this->timer.Stop();
+
+		if ( !result.has_value() )
 		{
-			return;
+			std::cout << "Failed To Find Sub Array In Data\n";
 		}
-		/// Set tempBuffer size
-		this->tempBuffer.resize( this->szArray );
-		/// Call the traditional merge sort
-		MergeSort( 0, this->szArray - 1 );
+		return result;
 	}
 
 	/**
-	* @brief Recursive Merge Sort implementation
+	* @brief Subarray sum search through the prefix sum index
 	*
-	* @param start Starting index of the array segment to sort
-	* @param end Ending index of the array segment to sort
+	* @return std::nullopt if not found, or a tuple where the first value is the
+	*         0th index of the subarray and the second is the length of the subarray
 	*/
-	void MergeSort( T start, T end )
+	std::optional<std::tuple<std::size_t, std::size_t>> PrefixSumSearch()
 	{
-		/// Base case: if the subarray has 0 or 1 element, it's already sorted
-		if ( start >= end ) return;
+		// Print algorithm name
+		this->PrintAlgoName( "Prefix Sum Search" );
 
-		/// Calculate the middle point to divide the array into two halves
-		const T mid = std::midpoint( start, end );
+		/// Start Timer
+		this->timer.Start();
 
-		/// Recursively sort the first half
-		MergeSort( start, mid );
+		/// our result for search
+		const auto result = PrefixSumSearchCore();
 
-		/// Recursively sort the second half
-		MergeSort( mid + 1, end );
+		// End Timer
+		this->timer.Stop();
 
-		/// Merge the sorted halves
-		Merge( start, mid, end );
+		if ( !result.has_value() )
+		{
+			std::cout << "Failed To Find Sub Array In Data\n";
+		}
+		return result;
 	}
 
+
+	///--------------Search-Cores--------------///
+
 	/**
-	* @brief Merges two sorted subarrays into a single sorted array
+	* @brief Linear search on the current array, no printing or timing
+	*
+	* Vectorized when T has a kernel, see VectorSearch
 	*
-	* @param start Starting index of first subarray
-	* @param mid Ending index of first subarray
-	* @param end Ending index of second subarray
+	* @return Index of the linear search value, or SIZE_MAX if not found
 	*/
-	void Merge( T start, T mid, T end )
+	std::size_t LinearSearchCore() const
 	{
-		/// Copy elements to the temp buffer
-		for ( T i = start; i <= end; i++ )
+		return SearchCores::LinearSearch( this->view, sValues[ 1 ] );
+	}
+
+	/**
+	* @brief Binary search on the current array, no printing or timing
+	*
+	* @return Index of the binary search value, or SIZE_MAX if not found
+	*/
+	std::size_t BinarySearchCore() const
+	{
+		return SearchCores::BinarySearch( this->view, sValues[ 0 ] );
+	}
+
+	/**
+	* @brief Streams the array through a StreamingWindow of sSumLen samples,
+	* no printing or timing
+	*
+	* Only looks at windows of exactly sSumLen, where SlidingWindow also
+	* takes shorter ones, but nothing is kept past the window, so the same
+	* loop works on a stream that never ends
+	*
+	* @return std::nullopt if not found, or a tuple of the 0th index
+	*         and the length of the subarray
+	*/
+	std::optional<std::tuple<std::size_t, std::size_t>> StreamingWindowCore() const
+	{
+		StreamingWindow<T> stream( sSumLen );
+		const auto target = static_cast< typename StreamingWindow<T>::SumType >( sSumValue );
+
+		for ( std::size_t i = 0; i < this->szArray; ++i )
 		{
-			this->tempBuffer[ i ] = this->array[ i ];
+			stream.Push( this->view[ i ] );
+			if ( stream.Count() == sSumLen && stream.Sum() == target )
+			{
+				return std::make_tuple( i + 1 - sSumLen, sSumLen );
+			}
 		}
+		return std::nullopt;
+	}
+
+	/**
+	* @brief Subarray sum search through the prefix sum index, no printing or timing
+	*
+	* This can find a different subarray than SlidingWindow
+	* when more than one has the same sum
+	*
+	* @return std::nullopt if not found, or a tuple of the 0th index
+	*         and the length of the subarray
+	*/
+	std::optional<std::tuple<std::size_t, std::size_t>> PrefixSumSearchCore() const
+	{
+		return sumIndex.FindSubarray( sSumValue );
+	}
 
-		/// Initial index of first, second halves
-		T i = start;
-		T j = mid + 1;
-		/// Initial index of merged array
-		T k = start;
+	/**
+	* @brief Gets the sum of a subarray from the prefix sum index
+	*
+	* @param subarray Start index and length of the subarray
+	* @return Sum of the subarray
+	*/
+	T SubarraySum( const std::tuple<std::size_t, std::size_t>& subarray ) const
+	{
+		return static_cast< T >( sumIndex.RangeSum( std::get<0>( subarray ), std::get<1>( subarray ) ) );
+	}
+
+	/**
+	* @brief Reads the whole array on the pool as 8 byte words, the
+	* bandwidth baseline for the parallel scan
+	*
+	* @return XOR of every word, so the reads can't be thrown away
+	*/
+	std::uint64_t StreamRead()
+	{
+		const auto* bytes = reinterpret_cast< const unsigned char* >( this->view.data() );
+		const std::size_t words = this->szArray * sizeof( T ) / sizeof( std::uint64_t );
+		const std::size_t chunks = pool->GetThreadCount() * 4;
 
-		/// Merge the two halves back into the original array
-		while ( i <= mid && j <= end )
+		std::vector<std::uint64_t> partial( chunks );
+		TaskGroup group( *pool );
+		for ( std::size_t c = 0; c < chunks; ++c )
 		{
-			if ( this->tempBuffer[ i ] <= this->tempBuffer[ j ] )
+			group.Run( [ &, c ]()
 			{
-				this->array[ k++ ] = this->tempBuffer[ i++ ];
-			} else
+				std::uint64_t sum = 0;
+				for ( std::size_t w = words * c / chunks; w < words * ( c + 1 ) / chunks; ++w )
+				{
+					std::uint64_t word;
+					std::memcpy( &word, bytes + w * sizeof( std::uint64_t ), sizeof( word ) );
+					sum ^= word;
+				}
+				partial[ c ] = sum;
+			} );
+		}
+		group.Wait();
+
+		return std::accumulate( partial.begin(), partial.end(), std::uint64_t( 0 ), std::bit_xor<>() );
+	}
+
+	/**
+	* @brief Binary search through the Eytzinger index, no printing or timing
+	*
+	* @return Index of the binary search value in the sorted array, or SIZE_MAX if not found
+	*/
+	std::size_t IndexSearchCore() const
+	{
+		return searchIndex.Find( sValues[ 0 ] ).value_or( SIZE_MAX );
+	}
+
+	/**
+	* @brief Sliding window search on the current array, no printing or timing
+	*
+	* @return std::nullopt if not found, or a tuple of the 0th index
+	*         and the length of the subarray
+	*/
+	std::optional<std::tuple<std::size_t, std::size_t>> SlidingWindowCore() const
+	{
+		return SearchCores::SlidingWindow( this->view, sSumValue, sSumLen );
+	}
+
+	/**
+	* @brief Times SEARCH_BENCH_KEYS lookups done one at a time, with
+	* LowerBoundBatch and through the Eytzinger index
+	*
+	* @param runner Runner to time with
+	* @param report Called with the name and stats of each benchmark
+	*/
+	template< typename Report >
+	void BenchBatchedSearch( BenchmarkRunner& runner, Report&& report )
+	{
+		const BenchStats single = runner.Run( batchKeys.size(), []() {}, [ & ]()
+		{
+			for ( std::size_t k = 0; k < batchKeys.size(); ++k )
 			{
-				this->array[ k++ ] = this->tempBuffer[ j++ ];
+				batchResults[ k ] = LowerBound( batchKeys[ k ] );
 			}
-		}
+		} );
+		report( "Lower Bound Per Key", single );
+
+		const BenchStats batched = runner.Run( batchKeys.size(), []() {}, [ & ]()
+		{
+			LowerBoundBatch( batchKeys, batchResults );
+		} );
+		report( "Batched Lower Bound", batched );
+
+		const BenchStats eytzinger = runner.Run( batchKeys.size(), []() {}, [ & ]()
+		{
+			for ( std::size_t k = 0; k < batchKeys.size(); ++k )
+			{
+				batchResults[ k ] = searchIndex.LowerBound( batchKeys[ k ] );
+			}
+		} );
+		report( "Eytzinger Per Key", eytzinger );
+	}
 
-		/// Copy remaining elements of the first half, if any
-		while ( i <= mid )
+	///---------------Merge-Sort-Start---------------///
+
+	/**
+	* @brief Initializes and executes the Merge Sort algorithm
+	*/
+	void MergeSortInit()
+	{
+		this->InitArray();
+		// Edge case check
+		if ( this->szArray == 0 || this->szArray == 1 )
 		{
-			this->array[ k++ ] = this->tempBuffer[ i++ ];
+			return;
 		}
+		/// Set tempBuffer size
+		this->tempBuffer.resize( this->szArray );
+		/// Call the traditional merge sort
+		SortCores::MergeSort( this->view, std::span<T>( this->tempBuffer ) );
 	}
 
 
@@ -328,7 +847,8 @@ private:
 
 
 	/**
-	* @brief Initializes and sorts the array
+	* @brief Initializes and sorts the array, and builds the Eytzinger
+	* and prefix sum indexes
 	*
 	* Then gets the search values for Linear/Binary search
 	* We then get/set our sub array details for sliding window search
@@ -336,12 +856,25 @@ private:
 	void InitData()
 	{
 		MergeSortInit();
+		searchIndex.Build( this->view );
+		sumIndex.Build( this->view );
+		InitSearchValues();
+	}
+
+	/**
+	* @brief Picks the search values from the current array
+	*
+	* Linear/Binary search values are random elements of the array,
+	* the sliding window sum is from a random sub array
+	*/
+	void InitSearchValues()
+	{
 		/// Generator and device
 		std::random_device rd;
 		std::mt19937 gen( rd() );
 
 		/// Set the distribution for search values
-		std::uniform_int_distribution<std::size_t> sizeDist( 0, this->szArray );
+		std::uniform_int_distribution<std::size_t> sizeDist( 0, this->szArray - 1 );
 		/// Set the distribution for sliding window sub array
 		std::uniform_int_distribution<std::size_t> sADist( 0, this->szArray - 21 );
 		/// Set the distribution for the sub array length
@@ -351,18 +884,41 @@ private:
 		// Set the sub array start index
 		sSumStart = sADist( gen );
 		// Set the binary search value
-		sValues[ 0 ] = this->array[ sizeDist( gen ) ];
+		sValues[ 0 ] = this->view[ sizeDist( gen ) ];
 		// Set the linear search value
-		sValues[ 1 ] = this->array[ sizeDist( gen ) ];
+		sValues[ 1 ] = this->view[ sizeDist( gen ) ];
 
 		// Get random sub array length
 		sSumLen = sizeSumDist( gen );
 
 		// Calculate sub array sum, yes there is functions for this
 		// But this is simple for our learning and works
+		sSumValue = 0;
 		for ( std::size_t i = sSumStart; i < sSumLen + sSumStart; ++i )
 		{
-			sSumValue += this->array[ i ];
+			sSumValue += this->view[ i ];
+		}
+
+		// Keys for the batched search, all of them are in the array
+		batchKeys.resize( SEARCH_BENCH_KEYS );
+		batchResults.resize( SEARCH_BENCH_KEYS );
+		for ( T& key : batchKeys )
+		{
+			key = this->view[ sizeDist( gen ) ];
+		}
+
+		// Targets for the batched subarray sums, each is the sum of a random sub array
+		batchSums.resize( SUM_BENCH_QUERIES );
+		batchSumResults.resize( SUM_BENCH_QUERIES );
+		for ( T& sum : batchSums )
+		{
+			const std::size_t start = sADist( gen );
+			const std::size_t length = sizeSumDist( gen );
+			sum = 0;
+			for ( std::size_t i = start; i < start + length; ++i )
+			{
+				sum += this->view[ i ];
+			}
 		}
 	}
 };
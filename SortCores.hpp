@@ -0,0 +1,1445 @@
+#ifndef SORTCORES_HPP
+#define SORTCORES_HPP
+
+
+#include "ClassBase.hpp"
+#include "SortingNetworks.hpp"
+#include "ThreadPool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <array>
+#include <bit>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+
+/**
+* @brief The sorts from SortingAlgorithms as free functions over a span
+*
+* Nothing here prints, times or allocates. Sorts that need a second buffer
+* take it as scratch, which must be at least as big as the data, so they can
+* run on any buffer the caller owns: a vector, a mapped file, part of a
+* bigger array. SortingAlgorithms wraps these for its demos and benchmarks.
+*
+* Like std::ranges::sort every comparison sort takes a comparator and a
+* projection, so records can be sorted by a field. With the defaults ( less
+* and identity ) the leaf ranges go to the sorting networks, with anything
+* else they are insertion sorted with the comparator. Radix sort only
+* knows the natural order of numbers, SortByKey is the fast path for
+* records with a numeric key. ArgSort, BuildPermutePlan and ApplyPermutation
+* do the same for a table stored as separate columns.
+*
+* The parallel merge sort still hands its tasks to the pool, which is the
+* only place memory is allocated.
+*/
+namespace SortCores
+{
+    /// Ranges this size or smaller are finished with a sorting network
+    inline constexpr std::size_t QUICK_SORT_LEAF_SIZE = SortingNetworks::MAX_NETWORK_SIZE;
+    /// Ranges bigger than this use the ninther for the pivot, else median of three
+    inline constexpr std::size_t QUICK_SORT_NINTHER_THRESHOLD = 128;
+    /// Size of the runs the bottom up merge sort sorts with a network before merging
+    inline constexpr std::size_t MERGE_SORT_RUN_SIZE = SortingNetworks::MAX_NETWORK_SIZE;
+    /// Ranges this size or smaller are sorted on one thread
+    inline constexpr std::size_t PARALLEL_SORT_GRAIN = 1 << 14;
+    /// Minimum output elements each parallel merge task handles
+    inline constexpr std::size_t PARALLEL_MERGE_GRAIN = 1 << 15;
+    /// Arrays smaller than this are cheaper to sort with introsort than radix sort
+    inline constexpr std::size_t RADIX_SORT_MIN_SIZE = 256;
+    /// Entries ahead of a gather that the row is prefetched for
+    inline constexpr std::size_t KEY_SORT_PREFETCH_DISTANCE = 16;
+    /// Source rows per block of a PermutePlan, 256KB of 64 bit values so a block stays in L2
+    inline constexpr std::size_t PERMUTE_BLOCK_ROWS = 1 << 15;
+
+    /// True for the default comparator and projection, where the networks can be used
+    template< typename Comp, typename Proj >
+    inline constexpr bool isDefaultOrder = std::is_same_v< Comp, std::ranges::less > && std::is_same_v< Proj, std::identity >;
+
+    /**
+    * @brief Checks if a goes before b, comparing their projections
+    *
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to both elements first
+    * @param a First element
+    * @param b Second element
+    * @return true if a's key is less than b's key
+    */
+    template< typename Comp, typename Proj, typename T >
+    constexpr bool Before( Comp& comp, Proj& proj, const T& a, const T& b )
+    {
+        return std::invoke( comp, std::invoke( proj, a ), std::invoke( proj, b ) );
+    }
+
+    /**
+    * @brief Xor Swap algorithm, anything that isn't an
+    * integer can't be xor'd so it uses std::swap
+    *
+    * @param a First value to swap
+    * @param b Second value to swap
+    */
+    template< typename T >
+    void XorSwap( T& a, T& b )
+    {
+        if constexpr ( std::is_integral_v< T > )
+        {
+            /// Short circuit, this also covers a and b being the same element
+            if ( a == b ) return;
+
+            a ^= b;
+            b ^= a;
+            a ^= b;
+        } else
+        {
+            using std::swap;
+            swap( a, b );
+        }
+    }
+
+    ///-------------Quadratic-Sorts-----------------///
+
+    /**
+    * @brief Bubble sort
+    *
+    * @param data Elements to sort
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp = std::ranges::less, typename Proj = std::identity >
+    void BubbleSort( std::span< T > data, Comp comp = {}, Proj proj = {} )
+    {
+        const std::size_t size = data.size();
+        if ( size < 2 )
+        {
+            return;
+        }
+
+        for ( std::size_t i = 0; i < size - 1; ++i )
+        {
+            for ( std::size_t j = 0; j < size - i - 1; ++j )
+            {
+                if ( Before( comp, proj, data[ j + 1 ], data[ j ] ) )
+                {
+                    XorSwap( data[ j ], data[ j + 1 ] );
+                }
+            }
+        }
+    }
+
+    /**
+    * @brief Selection sort
+    *
+    * @param data Elements to sort
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp = std::ranges::less, typename Proj = std::identity >
+    void SelectionSort( std::span< T > data, Comp comp = {}, Proj proj = {} )
+    {
+        const std::size_t size = data.size();
+        if ( size < 2 )
+        {
+            return;
+        }
+
+        std::size_t minValueIndex = 0;
+        for ( std::size_t i = 0; i < size - 1; ++i )
+        {
+            /// Reset minValueIndex
+            minValueIndex = i;
+
+            /// Iterate through unsorted portion
+            for ( std::size_t j = i + 1; j < size; ++j )
+            {
+                if ( !Before( comp, proj, data[ minValueIndex ], data[ j ] ) )
+                {
+                    minValueIndex = j;
+                }
+            }
+            if ( minValueIndex != i )
+            {
+                /// Make swap
+                XorSwap( data[ i ], data[ minValueIndex ] );
+            }
+        }
+    }
+
+    /**
+    * @brief Insertion sort
+    *
+    * @param data Elements to sort
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp = std::ranges::less, typename Proj = std::identity >
+    void InsertionSort( std::span< T > data, Comp comp = {}, Proj proj = {} )
+    {
+        std::ptrdiff_t j;
+        for ( std::size_t i = 1; i < data.size(); ++i )
+        {
+            T comparand = std::move( data[ i ] );
+            j = static_cast< std::ptrdiff_t >( i ) - 1;
+            while ( j >= 0 && Before( comp, proj, comparand, data[ j ] ) )
+            {
+                data[ j + 1 ] = std::move( data[ j ] );
+                --j;
+            }
+
+            data[ j + 1 ] = std::move( comparand );
+        }
+    }
+
+    /**
+    * @brief Sorts a leaf range of the quick and merge sorts
+    *
+    * The default order goes to the sorting networks, anything
+    * else is insertion sorted with the comparator
+    *
+    * @param data The elements
+    * @param first First index of the range
+    * @param last One past the last index of the range
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp, typename Proj >
+    void SortLeaf( std::span< T > data, const std::size_t first, const std::size_t last, Comp& comp, Proj& proj )
+    {
+        if constexpr ( isDefaultOrder< Comp, Proj > )
+        {
+            SortingNetworks::SortSmall( data.data() + first, last - first );
+        } else
+        {
+            InsertionSort( data.subspan( first, last - first ), comp, proj );
+        }
+    }
+
+    ///-------------Quick-Sort-Start-----------------///
+
+    /**
+    * @brief Gets the index of the median of three elements
+    *
+    * @param data The elements
+    * @param a Index of first element
+    * @param b Index of second element
+    * @param c Index of third element
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    * @return Index of the median element
+    */
+    template< typename T, typename Comp, typename Proj >
+    std::size_t MedianOfThree( std::span< const T > data, const std::size_t a, const std::size_t b, const std::size_t c,
+                               Comp& comp, Proj& proj )
+    {
+        if ( Before( comp, proj, data[ a ], data[ b ] ) )
+        {
+            if ( Before( comp, proj, data[ b ], data[ c ] ) )
+            {
+                return b;
+            }
+            return Before( comp, proj, data[ a ], data[ c ] ) ? c : a;
+        }
+
+        if ( Before( comp, proj, data[ a ], data[ c ] ) )
+        {
+            return a;
+        }
+        return Before( comp, proj, data[ b ], data[ c ] ) ? c : b;
+    }
+
+    /**
+    * @brief Picks the pivot value for a range
+    *
+    * Small ranges use the median of the first, middle and last element.
+    * Large ranges use Tukey's ninther, the median of three medians of three,
+    * which holds up much better against organ pipe and sawtooth input
+    *
+    * @param data The elements
+    * @param first First index of the range
+    * @param last One past the last index of the range
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    * @return The pivot value
+    */
+    template< typename T, typename Comp, typename Proj >
+    T ChoosePivot( std::span< const T > data, const std::size_t first, const std::size_t last, Comp& comp, Proj& proj )
+    {
+        const std::size_t size = last - first;
+        const std::size_t mid = first + size / 2;
+
+        if ( size > QUICK_SORT_NINTHER_THRESHOLD )
+        {
+            const std::size_t step = size / 8;
+            return data[ MedianOfThree( data,
+                MedianOfThree( data, first, first + step, first + step * 2, comp, proj ),
+                MedianOfThree( data, mid - step, mid, mid + step, comp, proj ),
+                MedianOfThree( data, last - 1 - step * 2, last - 1 - step, last - 1, comp, proj ), comp, proj ) ];
+        }
+        return data[ MedianOfThree( data, first, mid, last - 1, comp, proj ) ];
+    }
+
+    /**
+    * @brief Three way ( dutch national flag ) partition around the pivot
+    *
+    * Elements equal to the pivot end up in the middle and are never
+    * touched again, so all equal and few unique input is linear
+    *
+    * @param data The elements
+    * @param first First index of the range
+    * @param last One past the last index of the range
+    * @param pivot The pivot value
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    * @return Pair of indexes, [ first, lower ) is less than the pivot,
+    *         [ lower, upper ) is equal and [ upper, last ) is greater
+    */
+    template< typename T, typename Comp = std::ranges::less, typename Proj = std::identity >
+    std::pair< std::size_t, std::size_t > QuickPartition( std::span< T > data, const std::size_t first, const std::size_t last,
+                                                          const T& pivot, Comp comp = {}, Proj proj = {} )
+    {
+        std::size_t lower = first;
+        std::size_t i = first;
+        std::size_t upper = last;
+
+        while ( i < upper )
+        {
+            if ( Before( comp, proj, data[ i ], pivot ) )
+            {
+                std::swap( data[ lower++ ], data[ i++ ] );
+            } else if ( Before( comp, proj, pivot, data[ i ] ) )
+            {
+                std::swap( data[ i ], data[ --upper ] );
+            } else
+            {
+                ++i;
+            }
+        }
+        return { lower, upper };
+    }
+
+    /**
+    * @brief Moves an element down a max heap until
+    * both its children are smaller
+    *
+    * @param data The elements
+    * @param first First index of the heap in data
+    * @param root Heap index of the element to move
+    * @param size Number of elements in the heap
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp, typename Proj >
+    void HeapSiftDown( std::span< T > data, const std::size_t first, std::size_t root, const std::size_t size, Comp& comp, Proj& proj )
+    {
+        T value = std::move( data[ first + root ] );
+        std::size_t child = root * 2 + 1;
+
+        while ( child < size )
+        {
+            /// Pick the larger child
+            if ( child + 1 < size && Before( comp, proj, data[ first + child ], data[ first + child + 1 ] ) )
+            {
+                ++child;
+            }
+
+            if ( !Before( comp, proj, value, data[ first + child ] ) )
+            {
+                break;
+            }
+
+            data[ first + root ] = std::move( data[ first + child ] );
+            root = child;
+            child = root * 2 + 1;
+        }
+        data[ first + root ] = std::move( value );
+    }
+
+    /**
+    * @brief Moves an element up a max heap until its parent is not smaller
+    *
+    * @param data The elements
+    * @param first First index of the heap in data
+    * @param child Heap index of the element to move
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp, typename Proj >
+    void HeapSiftUp( std::span< T > data, const std::size_t first, std::size_t child, Comp& comp, Proj& proj )
+    {
+        T value = std::move( data[ first + child ] );
+
+        while ( child > 0 )
+        {
+            const std::size_t parent = ( child - 1 ) / 2;
+            if ( !Before( comp, proj, data[ first + parent ], value ) )
+            {
+                break;
+            }
+
+            data[ first + child ] = std::move( data[ first + parent ] );
+            child = parent;
+        }
+        data[ first + child ] = std::move( value );
+    }
+
+    /**
+    * @brief Turns part of the data into a max heap
+    *
+    * @param data The elements
+    * @param first First index of the range
+    * @param last One past the last index of the range
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp, typename Proj >
+    void MakeHeap( std::span< T > data, const std::size_t first, const std::size_t last, Comp& comp, Proj& proj )
+    {
+        const std::size_t size = last - first;
+        for ( std::size_t i = size / 2; i-- > 0; )
+        {
+            HeapSiftDown( data, first, i, size, comp, proj );
+        }
+    }
+
+    /**
+    * @brief Sorts a max heap by moving the max to the end and shrinking the heap
+    *
+    * @param data The elements
+    * @param first First index of the heap
+    * @param last One past the last index of the heap
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp, typename Proj >
+    void SortHeap( std::span< T > data, const std::size_t first, const std::size_t last, Comp& comp, Proj& proj )
+    {
+        for ( std::size_t end = last - first; end > 1; --end )
+        {
+            std::swap( data[ first ], data[ first + end - 1 ] );
+            HeapSiftDown( data, first, 0, end - 1, comp, proj );
+        }
+    }
+
+    /**
+    * @brief Heap sort on part of the data, this is the
+    * fallback when quick sort recurses too deep
+    *
+    * @param data The elements
+    * @param first First index of the range
+    * @param last One past the last index of the range
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp, typename Proj >
+    void HeapSortRange( std::span< T > data, const std::size_t first, const std::size_t last, Comp& comp, Proj& proj )
+    {
+        MakeHeap( data, first, last, comp, proj );
+        SortHeap( data, first, last, comp, proj );
+    }
+
+    /**
+    * @brief Heap select, puts the smallest middle - first elements of
+    * the range in [ first, middle ) in order
+    *
+    * [ first, middle ) is kept as a max heap of the best so far, anything
+    * after it that beats the heap's max replaces it. O( n log k ), this is
+    * the fallback when the partial sort and select recurse too deep.
+    *
+    * @param data The elements
+    * @param first First index of the range
+    * @param middle One past the last index that ends up sorted
+    * @param last One past the last index of the range
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp, typename Proj >
+    void HeapSelectRange( std::span< T > data, const std::size_t first, const std::size_t middle, const std::size_t last,
+                          Comp& comp, Proj& proj )
+    {
+        MakeHeap( data, first, middle, comp, proj );
+        for ( std::size_t i = middle; i < last; ++i )
+        {
+            if ( Before( comp, proj, data[ i ], data[ first ] ) )
+            {
+                std::swap( data[ i ], data[ first ] );
+                HeapSiftDown( data, first, 0, middle - first, comp, proj );
+            }
+        }
+        SortHeap( data, first, middle, comp, proj );
+    }
+
+    /**
+    * @brief Introsort, quick sort that switches to heap sort
+    * once it goes past the depth limit
+    *
+    * We only recurse into the smaller side of each partition and
+    * loop on the larger side, so the stack is at most log n deep
+    *
+    * @param data The elements
+    * @param first First index of the range
+    * @param last One past the last index of the range
+    * @param depthLimit Partitions left before we fall back to heap sort
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp = std::ranges::less, typename Proj = std::identity >
+    void Introsort( std::span< T > data, std::size_t first, std::size_t last, std::size_t depthLimit, Comp comp = {}, Proj proj = {} )
+    {
+        while ( last - first > QUICK_SORT_LEAF_SIZE )
+        {
+            if ( depthLimit == 0 )
+            {
+                HeapSortRange( data, first, last, comp, proj );
+                return;
+            }
+            --depthLimit;
+
+            const T pivot = ChoosePivot< T >( data, first, last, comp, proj );
+            const auto [ lower, upper ] = QuickPartition( data, first, last, pivot, comp, proj );
+
+            if ( lower - first < last - upper )
+            {
+                Introsort( data, first, lower, depthLimit, comp, proj );
+                first = upper;
+            } else
+            {
+                Introsort( data, upper, last, depthLimit, comp, proj );
+                last = lower;
+            }
+        }
+        SortLeaf( data, first, last, comp, proj );
+    }
+
+    /**
+    * @brief Quick sort ( introsort ) with a depth limit of 2 * log2( n )
+    *
+    * @param data Elements to sort
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp = std::ranges::less, typename Proj = std::identity >
+    void QuickSort( std::span< T > data, Comp comp = {}, Proj proj = {} )
+    {
+        if ( data.size() < 2 )
+        {
+            return;
+        }
+        Introsort( data, 0, data.size(), 2 * ( std::bit_width( data.size() ) - 1 ), comp, proj );
+    }
+
+    ///--------------Selection-Start----------------///
+
+    /**
+    * @brief Introselect, quick select that switches to heap select
+    * once it goes past the depth limit
+    *
+    * The same partition as quick sort, but only the side holding nth is
+    * kept, so on average each step halves the range and the whole select
+    * is O( n ). If nth lands in the range equal to the pivot we are done.
+    *
+    * @param data The elements
+    * @param first First index of the range
+    * @param last One past the last index of the range
+    * @param nth Index that ends up holding the element it would in sorted order
+    * @param depthLimit Partitions left before we fall back to heap select
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp, typename Proj >
+    void Introselect( std::span< T > data, std::size_t first, std::size_t last, const std::size_t nth, std::size_t depthLimit,
+                      Comp& comp, Proj& proj )
+    {
+        while ( last - first > QUICK_SORT_LEAF_SIZE )
+        {
+            if ( depthLimit == 0 )
+            {
+                HeapSelectRange( data, first, nth + 1, last, comp, proj );
+                return;
+            }
+            --depthLimit;
+
+            const T pivot = ChoosePivot< T >( data, first, last, comp, proj );
+            const auto [ lower, upper ] = QuickPartition( data, first, last, pivot, comp, proj );
+
+            if ( nth < lower )
+            {
+                last = lower;
+            } else if ( nth >= upper )
+            {
+                first = upper;
+            } else
+            {
+                return;
+            }
+        }
+        SortLeaf( data, first, last, comp, proj );
+    }
+
+    /**
+    * @brief nth element, puts the element that belongs at nth in sorted order there
+    *
+    * Everything before nth is not greater than it and everything after is
+    * not less, neither side is sorted. nth = size / 2 gives the median.
+    *
+    * @param data The elements
+    * @param nth Index to select, must be less than data.size()
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp = std::ranges::less, typename Proj = std::identity >
+    void NthElement( std::span< T > data, const std::size_t nth, Comp comp = {}, Proj proj = {} )
+    {
+        if ( data.size() < 2 )
+        {
+            return;
+        }
+        Introselect( data, 0, data.size(), nth, 2 * ( std::bit_width( data.size() ) - 1 ), comp, proj );
+    }
+
+    /**
+    * @brief Introsort that only sorts what lands before k
+    *
+    * After each partition the side past k is dropped. The side before it
+    * is entirely in the first k, so it is sorted with a normal introsort,
+    * and only the side straddling k is looped on.
+    *
+    * @param data The elements
+    * @param first First index of the range
+    * @param last One past the last index of the range
+    * @param k Elements before k end up sorted
+    * @param depthLimit Partitions left before we fall back to heap select
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp, typename Proj >
+    void PartialIntrosort( std::span< T > data, std::size_t first, std::size_t last, const std::size_t k, std::size_t depthLimit,
+                           Comp& comp, Proj& proj )
+    {
+        while ( last - first > QUICK_SORT_LEAF_SIZE )
+        {
+            if ( depthLimit == 0 )
+            {
+                HeapSelectRange( data, first, k, last, comp, proj );
+                return;
+            }
+            --depthLimit;
+
+            const T pivot = ChoosePivot< T >( data, first, last, comp, proj );
+            const auto [ lower, upper ] = QuickPartition( data, first, last, pivot, comp, proj );
+
+            if ( k <= lower )
+            {
+                last = lower;
+                continue;
+            }
+
+            Introsort( data, first, lower, depthLimit, comp, proj );
+            if ( k <= upper )
+            {
+                return;
+            }
+            first = upper;
+        }
+        SortLeaf( data, first, last, comp, proj );
+    }
+
+    /**
+    * @brief Partial sort, the smallest k elements end up sorted at the front
+    *
+    * The order of the rest is unspecified. For k much smaller than the size
+    * most partitions throw away the larger side without sorting it, so this
+    * is close to O( n + k log k ).
+    *
+    * @param data The elements
+    * @param k Number of elements to sort, clamped to data.size()
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp = std::ranges::less, typename Proj = std::identity >
+    void PartialSort( std::span< T > data, std::size_t k, Comp comp = {}, Proj proj = {} )
+    {
+        k = std::min( k, data.size() );
+        if ( k == 0 || data.size() < 2 )
+        {
+            return;
+        }
+        PartialIntrosort( data, 0, data.size(), k, 2 * ( std::bit_width( data.size() ) - 1 ), comp, proj );
+    }
+
+    /**
+    * @brief Top k without touching the input, out.size() smallest elements sorted into out
+    *
+    * One pass over the data with a max heap of the best so far in out, an
+    * element only costs a heap update when it beats the heap's max. The data
+    * is read once front to back, so this also works when it is streamed, see
+    * StreamingTopK.
+    *
+    * @param data Elements to select from
+    * @param out Receives the smallest elements in order, its size is k
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    * @return Number of elements written, the smaller of k and data.size()
+    */
+    template< typename T, typename Comp = std::ranges::less, typename Proj = std::identity >
+    std::size_t TopK( std::span< const T > data, std::span< T > out, Comp comp = {}, Proj proj = {} )
+    {
+        const std::size_t count = std::min( out.size(), data.size() );
+        if ( count == 0 )
+        {
+            return 0;
+        }
+
+        std::copy( data.begin(), data.begin() + count, out.begin() );
+        MakeHeap( out, 0, count, comp, proj );
+        for ( std::size_t i = count; i < data.size(); ++i )
+        {
+            if ( Before( comp, proj, data[ i ], out[ 0 ] ) )
+            {
+                out[ 0 ] = data[ i ];
+                HeapSiftDown( out, 0, 0, count, comp, proj );
+            }
+        }
+        SortHeap( out, 0, count, comp, proj );
+        return count;
+    }
+
+    ///---------------Merge-Sort-Start---------------///
+
+    /**
+    * @brief Merges two sorted subarrays into a single sorted array
+    *
+    * @param data The elements
+    * @param scratch Buffer the subarrays are copied to, at least data.size()
+    * @param start Starting index of first subarray
+    * @param mid Ending index of first subarray
+    * @param end Ending index of second subarray
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp, typename Proj >
+    void Merge( std::span< T > data, std::span< T > scratch, const std::size_t start, const std::size_t mid, const std::size_t end,
+                Comp& comp, Proj& proj )
+    {
+        /// Copy elements to the temp buffer
+        for ( std::size_t i = start; i <= end; i++ )
+        {
+            scratch[ i ] = data[ i ];
+        }
+
+        /// Initial index of first, second halves
+        std::size_t i = start;
+        std::size_t j = mid + 1;
+        /// Initial index of merged array
+        std::size_t k = start;
+
+        /// Merge the two halves back into the original array
+        while ( i <= mid && j <= end )
+        {
+            if ( !Before( comp, proj, scratch[ j ], scratch[ i ] ) )
+            {
+                data[ k++ ] = scratch[ i++ ];
+            } else
+            {
+                data[ k++ ] = scratch[ j++ ];
+            }
+        }
+
+        /// Copy remaining elements of the first half, if any
+        while ( i <= mid )
+        {
+            data[ k++ ] = scratch[ i++ ];
+        }
+    }
+
+    /**
+    * @brief Recursive Merge Sort implementation
+    *
+    * @param data The elements
+    * @param scratch Buffer for the merges, at least data.size()
+    * @param start Starting index of the array segment to sort
+    * @param end Ending index of the array segment to sort
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp, typename Proj >
+    void MergeSort( std::span< T > data, std::span< T > scratch, const std::size_t start, const std::size_t end, Comp& comp, Proj& proj )
+    {
+        /// Base case: if the subarray has 0 or 1 element, it's already sorted
+        if ( start >= end ) return;
+
+        /// Calculate the middle point to divide the array into two halves
+        const std::size_t mid = std::midpoint( start, end );
+
+        /// Recursively sort the first half
+        MergeSort( data, scratch, start, mid, comp, proj );
+
+        /// Recursively sort the second half
+        MergeSort( data, scratch, mid + 1, end, comp, proj );
+
+        /// Merge the sorted halves
+        Merge( data, scratch, start, mid, end, comp, proj );
+    }
+
+    /**
+    * @brief Top down merge sort, stable
+    *
+    * @param data Elements to sort
+    * @param scratch Buffer for the merges, at least data.size()
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp = std::ranges::less, typename Proj = std::identity >
+    void MergeSort( std::span< T > data, std::span< T > scratch, Comp comp = {}, Proj proj = {} )
+    {
+        if ( data.size() < 2 )
+        {
+            return;
+        }
+        MergeSort( data, scratch, 0, data.size() - 1, comp, proj );
+    }
+
+    ///----------Bottom-Up-Merge-Sort-Start----------///
+
+    /**
+    * @brief Merges two sorted ranges into out, equal
+    * elements are taken from the first range first
+    *
+    * @param first First sorted range
+    * @param szFirst Size of first range
+    * @param second Second sorted range
+    * @param szSecond Size of second range
+    * @param out Where to write the szFirst + szSecond merged elements
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp, typename Proj >
+    void MergeSorted( const T* first, const std::size_t szFirst, const T* second, const std::size_t szSecond, T* out,
+                      Comp& comp, Proj& proj )
+    {
+        std::size_t i = 0;
+        std::size_t j = 0;
+
+        /// Branchless merge, on random data the compare is a coin
+        /// flip so a branch here mispredicts half the time
+        while ( i < szFirst && j < szSecond )
+        {
+            const bool takeSecond = Before( comp, proj, second[ j ], first[ i ] );
+            *out++ = takeSecond ? second[ j ] : first[ i ];
+            j += takeSecond;
+            i += !takeSecond;
+        }
+
+        /// Only one of these has anything left
+        out = std::copy( first + i, first + szFirst, out );
+        std::copy( second + j, second + szSecond, out );
+    }
+
+    /**
+    * @brief Iterative bottom up merge sort
+    *
+    * Runs of MERGE_SORT_RUN_SIZE are sorted with a network first. Each pass then
+    * merges pairs of runs from one buffer into the other, data and scratch
+    * swap roles every pass, so nothing is copied back until the very end. If
+    * two runs are already in order we copy them across instead of merging.
+    *
+    * @param data Elements to sort
+    * @param scratch Buffer the passes alternate with, at least data.size()
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp = std::ranges::less, typename Proj = std::identity >
+    void BottomUpMergeSort( std::span< T > data, std::span< T > scratch, Comp comp = {}, Proj proj = {} )
+    {
+        const std::size_t size = data.size();
+        if ( size < 2 )
+        {
+            return;
+        }
+
+        /// Sort the small runs in place
+        for ( std::size_t start = 0; start < size; start += MERGE_SORT_RUN_SIZE )
+        {
+            SortLeaf( data, start, std::min( start + MERGE_SORT_RUN_SIZE, size ), comp, proj );
+        }
+
+        T* src = data.data();
+        T* dst = scratch.data();
+
+        for ( std::size_t width = MERGE_SORT_RUN_SIZE; width < size; width *= 2 )
+        {
+            for ( std::size_t start = 0; start < size; start += width * 2 )
+            {
+                const std::size_t mid = std::min( start + width, size );
+                const std::size_t end = std::min( start + width * 2, size );
+
+                /// Runs are already in order, or there is no second run
+                if ( mid == end || !Before( comp, proj, src[ mid ], src[ mid - 1 ] ) )
+                {
+                    std::copy( src + start, src + end, dst + start );
+                } else
+                {
+                    MergeSorted( src + start, mid - start, src + mid, end - mid, dst + start, comp, proj );
+                }
+            }
+            std::swap( src, dst );
+        }
+
+        /// The sorted data ended up in scratch
+        if ( src != data.data() )
+        {
+            std::copy( src, src + size, data.data() );
+        }
+    }
+
+    ///-----------Parallel-Merge-Sort-Start----------///
+
+    /**
+    * @brief Finds how many elements of the first range are in
+    * the first k elements of the merged output ( co-ranking )
+    *
+    * This lets us split one merge into independent pieces, each
+    * piece is found with a binary search and no merging
+    *
+    * @param k Number of merged output elements
+    * @param first First sorted range
+    * @param szFirst Size of first range
+    * @param second Second sorted range
+    * @param szSecond Size of second range
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    * @return Elements taken from first, k minus this are taken from second
+    */
+    template< typename T, typename Comp, typename Proj >
+    std::size_t CoRank( const std::size_t k, const T* first, const std::size_t szFirst, const T* second, const std::size_t szSecond,
+                        Comp& comp, Proj& proj )
+    {
+        std::size_t low = k > szSecond ? k - szSecond : 0;
+        std::size_t high = std::min( k, szFirst );
+
+        while ( low < high )
+        {
+            const std::size_t i = std::midpoint( low, high );
+            const std::size_t j = k - i;
+
+            /// first[ i ] merges before second[ j - 1 ], so we need more from first
+            if ( j > 0 && !Before( comp, proj, second[ j - 1 ], first[ i ] ) )
+            {
+                low = i + 1;
+            } else
+            {
+                high = i;
+            }
+        }
+        return low;
+    }
+
+    /**
+    * @brief Merges two sorted ranges into out using the pool
+    *
+    * The output is cut into equal chunks, the co-rank of each chunk
+    * boundary tells us which input elements belong to it
+    *
+    * @param pool Pool to run the chunks on
+    * @param first First sorted range
+    * @param szFirst Size of first range
+    * @param second Second sorted range
+    * @param szSecond Size of second range
+    * @param out Where to write the merged elements
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp, typename Proj >
+    void ParallelMerge( ThreadPool& pool, const T* first, const std::size_t szFirst, const T* second, const std::size_t szSecond, T* out,
+                        Comp& comp, Proj& proj )
+    {
+        const std::size_t total = szFirst + szSecond;
+        const std::size_t chunks = std::clamp< std::size_t >( total / PARALLEL_MERGE_GRAIN, 1, pool.GetThreadCount() * 4 );
+
+        if ( chunks == 1 )
+        {
+            MergeSorted( first, szFirst, second, szSecond, out, comp, proj );
+            return;
+        }
+
+        TaskGroup group( pool );
+        for ( std::size_t c = 0; c < chunks; ++c )
+        {
+            group.Run( [ = ]() mutable
+            {
+                const std::size_t kStart = total * c / chunks;
+                const std::size_t kEnd = total * ( c + 1 ) / chunks;
+                const std::size_t iStart = CoRank( kStart, first, szFirst, second, szSecond, comp, proj );
+                const std::size_t iEnd = CoRank( kEnd, first, szFirst, second, szSecond, comp, proj );
+
+                MergeSorted( first + iStart, iEnd - iStart,
+                             second + ( kStart - iStart ), ( kEnd - iEnd ) - ( kStart - iStart ),
+                             out + kStart, comp, proj );
+            } );
+        }
+        group.Wait();
+    }
+
+    /**
+    * @brief Recursive parallel merge sort of [ start, end )
+    *
+    * Both halves are sorted in parallel into the other buffer, then
+    * merged back in parallel. Data and scratch swap roles each level
+    * so there is no copy back after every merge. The leaves are bottom
+    * up merge sorted and every merge takes from the first half on ties,
+    * so equal keys keep their order like the other merge sorts.
+    *
+    * @param pool Pool to run on
+    * @param data The elements
+    * @param scratch Buffer the levels alternate with, at least data.size()
+    * @param start First index of the range
+    * @param end One past the last index of the range
+    * @param intoScratch true if the sorted range should end up in scratch
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp, typename Proj >
+    void ParallelMergeSort( ThreadPool& pool, std::span< T > data, std::span< T > scratch,
+                            const std::size_t start, const std::size_t end, const bool intoScratch, Comp& comp, Proj& proj )
+    {
+        if ( end - start <= PARALLEL_SORT_GRAIN )
+        {
+            BottomUpMergeSort( data.subspan( start, end - start ), scratch.subspan( start, end - start ), comp, proj );
+            if ( intoScratch )
+            {
+                std::copy( data.begin() + start, data.begin() + end, scratch.begin() + start );
+            }
+            return;
+        }
+
+        const std::size_t mid = std::midpoint( start, end );
+        {
+            TaskGroup group( pool );
+            group.Run( [ &pool, data, scratch, start, mid, intoScratch, comp, proj ]() mutable
+            {
+                ParallelMergeSort( pool, data, scratch, start, mid, !intoScratch, comp, proj );
+            } );
+            ParallelMergeSort( pool, data, scratch, mid, end, !intoScratch, comp, proj );
+            group.Wait();
+        }
+
+        /// The halves are in the opposite buffer to where we want the result
+        const T* from = intoScratch ? data.data() : scratch.data();
+        T* to = intoScratch ? scratch.data() : data.data();
+        ParallelMerge( pool, from + start, mid - start, from + mid, end - mid, to + start, comp, proj );
+    }
+
+    /**
+    * @brief Parallel merge sort on the pool
+    *
+    * @param data Elements to sort
+    * @param scratch Buffer the levels alternate with, at least data.size()
+    * @param pool Pool to run on
+    * @param comp Comparator, a strict weak ordering
+    * @param proj Projection applied to elements before comparing
+    */
+    template< typename T, typename Comp = std::ranges::less, typename Proj = std::identity >
+    void ParallelMergeSort( std::span< T > data, std::span< T > scratch, ThreadPool& pool, Comp comp = {}, Proj proj = {} )
+    {
+        if ( data.size() < 2 )
+        {
+            return;
+        }
+        ParallelMergeSort( pool, data, scratch, 0, data.size(), false, comp, proj );
+    }
+
+    ///--------------Radix-Sort-Start---------------///
+
+    /// Numbers that fit a radix key, long double is wider than the widest key
+    template< typename T >
+    concept RadixSortable = std::is_arithmetic_v< T > && sizeof( T ) <= sizeof( std::uint64_t );
+
+    /// Unsigned integer the same size as T, this is what radix sort works on
+    template< typename T >
+        requires RadixSortable< T >
+    using RadixKey = std::conditional_t< sizeof( T ) == 1, std::uint8_t,
+                     std::conditional_t< sizeof( T ) == 2, std::uint16_t,
+                     std::conditional_t< sizeof( T ) == 4, std::uint32_t, std::uint64_t > > >;
+
+    /// Bits per digit, 11 bits for 32/64 bit keys ( 3 passes for 32 bit ), else 8
+    template< typename T >
+    inline constexpr std::size_t RADIX_DIGIT_BITS = sizeof( T ) >= 4 ? 11 : 8;
+    /// Buckets per digit
+    template< typename T >
+    inline constexpr std::size_t RADIX_BUCKETS = std::size_t( 1 ) << RADIX_DIGIT_BITS< T >;
+    /// Number of digits in a key
+    template< typename T >
+    inline constexpr std::size_t RADIX_PASSES = ( sizeof( T ) * 8 + RADIX_DIGIT_BITS< T > - 1 ) / RADIX_DIGIT_BITS< T >;
+
+    /**
+    * @brief Maps a value to an unsigned key with the same ordering
+    *
+    * Signed integers get their sign bit flipped. For floats positive
+    * values get the sign bit set, negative values have every bit flipped
+    * so larger magnitudes sort lower.
+    *
+    * @param value The value to map
+    * @return Key that compares as unsigned the same way value compares
+    */
+    template< typename T >
+        requires RadixSortable< T >
+    constexpr RadixKey< T > ToRadixKey( const T value )
+    {
+        using Key = RadixKey< T >;
+        constexpr Key signBit = Key( 1 ) << ( sizeof( T ) * 8 - 1 );
+        const Key bits = std::bit_cast< Key >( value );
+
+        if constexpr ( std::is_floating_point_v< T > )
+        {
+            return ( bits & signBit ) ? Key( ~bits ) : Key( bits | signBit );
+        } else if constexpr ( std::is_signed_v< T > )
+        {
+            return bits ^ signBit;
+        } else
+        {
+            return bits;
+        }
+    }
+
+    /**
+    * @brief Gets one digit of a key
+    *
+    * @param key The radix key
+    * @param pass Which digit, 0 is the least significant
+    * @return The digit
+    */
+    template< typename T >
+    constexpr std::size_t RadixDigit( const RadixKey< T > key, const std::size_t pass )
+    {
+        return static_cast< std::size_t >( key >> ( pass * RADIX_DIGIT_BITS< T > ) ) & ( RADIX_BUCKETS< T > - 1 );
+    }
+
+    /**
+    * @brief LSD radix sort on a key taken from each element
+    *
+    * One read of the data builds the histogram of every digit. Each pass
+    * then scatters from one buffer into the other, data and scratch swap
+    * roles like the bottom up merge sort. Digits that are the same for
+    * every element ( high bytes of small values ) are skipped. Every pass
+    * keeps equal keys in order, so the sort is stable.
+    *
+    * The histograms live on the stack, 96KB for 64 bit keys.
+    *
+    * @param data Elements to sort
+    * @param scratch Buffer the passes alternate with, at least data.size()
+    * @param keyOf Gets the unsigned radix key of an element
+    */
+    template< typename T, typename KeyOf >
+    void RadixSortBy( std::span< T > data, std::span< T > scratch, KeyOf keyOf )
+    {
+        using Key = std::remove_cvref_t< std::invoke_result_t< KeyOf&, const T& > >;
+        static_assert( std::is_unsigned_v< Key >, "radix keys must be unsigned, see ToRadixKey" );
+
+        constexpr std::size_t buckets = RADIX_BUCKETS< Key >;
+        constexpr std::size_t passes = RADIX_PASSES< Key >;
+        const std::size_t size = data.size();
+        if ( size < 2 )
+        {
+            return;
+        }
+
+        /// Histogram of every digit, in one pass over the data
+        std::array< std::size_t, passes * buckets > counts{};
+        for ( const T& value : data )
+        {
+            const Key key = keyOf( value );
+            for ( std::size_t pass = 0; pass < passes; ++pass )
+            {
+                ++counts[ pass * buckets + RadixDigit< Key >( key, pass ) ];
+            }
+        }
+
+        T* src = data.data();
+        T* dst = scratch.data();
+        const Key firstKey = keyOf( src[ 0 ] );
+
+        for ( std::size_t pass = 0; pass < passes; ++pass )
+        {
+            std::size_t* offsets = counts.data() + pass * buckets;
+
+            /// Every element has the same digit, this pass would change nothing
+            if ( offsets[ RadixDigit< Key >( firstKey, pass ) ] == size )
+            {
+                continue;
+            }
+
+            /// Turn the counts into starting offsets
+            std::exclusive_scan( offsets, offsets + buckets, offsets, std::size_t( 0 ) );
+
+            for ( std::size_t i = 0; i < size; ++i )
+            {
+                dst[ offsets[ RadixDigit< Key >( keyOf( src[ i ] ), pass ) ]++ ] = src[ i ];
+            }
+            std::swap( src, dst );
+        }
+
+        /// The sorted data ended up in scratch
+        if ( src != data.data() )
+        {
+            std::copy( src, src + size, data.data() );
+        }
+    }
+
+    /**
+    * @brief LSD radix sort of numbers in their natural order, see RadixSortBy
+    *
+    * @param data Elements to sort
+    * @param scratch Buffer the passes alternate with, at least data.size()
+    */
+    template< typename T >
+        requires RadixSortable< T >
+    void RadixSort( std::span< T > data, std::span< T > scratch )
+    {
+        const std::size_t size = data.size();
+        if ( size < RADIX_SORT_MIN_SIZE )
+        {
+            if ( size > 1 )
+            {
+                Introsort( data, 0, size, 2 * ( std::bit_width( size ) - 1 ) );
+            }
+            return;
+        }
+        RadixSortBy( data, scratch, []( const T value ) { return ToRadixKey( value ); } );
+    }
+
+    ///-------------Key-Sort-Start-----------------///
+
+    /**
+    * @brief Packed radix key of an element and where the element was,
+    * this is what ArgSort sorts instead of the elements themselves
+    */
+    template< typename K >
+    struct KeyIndex
+    {
+        K key; //< Radix key of the element's sort key
+        std::uint32_t index; //< Index of the element before sorting
+    };
+
+    /// Numeric sort key proj gets from a T
+    template< typename T, typename Proj >
+    using ProjectedKey = std::remove_cvref_t< std::invoke_result_t< Proj&, const T& > >;
+
+    /// Packed entry ArgSort uses for T sorted by proj
+    template< typename T, typename Proj >
+    using SortKey = KeyIndex< RadixKey< ProjectedKey< T, Proj > > >;
+
+    /**
+    * @brief Copies elements into out in the order of a sorted key array
+    *
+    * The reads jump around, so each one is prefetched KEY_SORT_PREFETCH_DISTANCE
+    * entries ahead while the writes go straight down out. That is several
+    * times faster than moving the elements in place along the permutation's
+    * cycles, where every move waits on the miss before it.
+    *
+    * @param order Sorted entries, order[ i ].index is the element that goes to out[ i ]
+    * @param data Elements to read from, they are moved out of
+    * @param out Where the elements go, at least order.size()
+    */
+    template< typename T, typename K >
+    void GatherByKeys( std::span< const KeyIndex< K > > order, std::span< T > data, std::span< T > out )
+    {
+        const std::size_t size = order.size();
+        for ( std::size_t i = 0; i < size; ++i )
+        {
+            if ( i + KEY_SORT_PREFETCH_DISTANCE < size )
+            {
+                Prefetch( data.data() + order[ i + KEY_SORT_PREFETCH_DISTANCE ].index );
+            }
+            out[ i ] = std::move( data[ order[ i ].index ] );
+        }
+    }
+
+    /**
+    * @brief A sorted order split into cache sized blocks, made once by
+    * BuildPermutePlan and then applied to every column of a table
+    */
+    struct PermutePlan
+    {
+        std::span< std::uint32_t > sources; //< Source row of each staging slot, grouped by source block
+        std::span< std::uint32_t > slots; //< Staging slot of each output row
+    };
+
+    /**
+    * @brief One column of a table for ApplyPermutation
+    */
+    template< typename T >
+    struct PermuteColumn
+    {
+        std::span< T > data; //< The column, sorted in place
+        std::span< T > scratch; //< Staging buffer, at least data.size()
+    };
+
+    /**
+    * @brief Gets the number of source blocks a plan over size rows has
+    *
+    * @param size Rows in the table
+    * @return Blocks of PERMUTE_BLOCK_ROWS, the last one can be short
+    */
+    constexpr std::size_t PermutePlanBlocks( const std::size_t size )
+    {
+        return ( size + PERMUTE_BLOCK_ROWS - 1 ) / PERMUTE_BLOCK_ROWS;
+    }
+
+    /**
+    * @brief Splits a sorted order into the two passes ApplyPermutation makes
+    *
+    * Applying an order straight to a column reads the column at random, and
+    * once the column is bigger than the cache every read is a miss. Here the
+    * source rows are split into blocks of PERMUTE_BLOCK_ROWS. Each block gets
+    * a run of staging slots, filled in output order. Pass one reads a block
+    * of the column into its staging run, the reads stay inside one block so
+    * they hit L2, and the writes are sequential. Pass two reads the staging
+    * runs into the output in order, that is one forward stream per block.
+    *
+    * Nothing in the plan depends on the column, so it is made once and every
+    * column only pays for the two cache friendly passes. Making the plan
+    * costs about as much as one random gather, so it wins from the second
+    * or third column on.
+    *
+    * @param order Sorted entries from ArgSort
+    * @param sources Buffer for the plan, at least order.size()
+    * @param slots Buffer for the plan, at least order.size()
+    * @param cursors Fill counts while building, at least PermutePlanBlocks( order.size() )
+    * @return The plan over sources and slots
+    */
+    template< typename K >
+    PermutePlan BuildPermutePlan( std::span< const KeyIndex< K > > order, std::span< std::uint32_t > sources,
+                                  std::span< std::uint32_t > slots, std::span< std::uint32_t > cursors )
+    {
+        const std::size_t size = order.size();
+
+        /// Every block is a permutation's worth of rows, so each run is exactly its block
+        for ( std::size_t block = 0; block < PermutePlanBlocks( size ); ++block )
+        {
+            cursors[ block ] = static_cast< std::uint32_t >( block * PERMUTE_BLOCK_ROWS );
+        }
+
+        for ( std::size_t i = 0; i < size; ++i )
+        {
+            const std::uint32_t row = order[ i ].index;
+            const std::uint32_t slot = cursors[ row / PERMUTE_BLOCK_ROWS ]++;
+            sources[ slot ] = row;
+            slots[ i ] = slot;
+        }
+
+        return { sources.first( size ), slots.first( size ) };
+    }
+
+    /**
+    * @brief Sorts one column in place with a plan, see BuildPermutePlan
+    *
+    * @param plan Plan from BuildPermutePlan
+    * @param column The column and its staging buffer
+    */
+    template< typename T >
+    void ApplyPermutation( const PermutePlan& plan, const PermuteColumn< T >& column )
+    {
+        const std::size_t size = plan.slots.size();
+
+        /// Reads stay inside one block at a time, writes go straight down the staging buffer
+        for ( std::size_t slot = 0; slot < size; ++slot )
+        {
+            column.scratch[ slot ] = std::move( column.data[ plan.sources[ slot ] ] );
+        }
+
+        /// One forward read stream per block, writes go straight down the column
+        for ( std::size_t i = 0; i < size; ++i )
+        {
+            column.data[ i ] = std::move( column.scratch[ plan.slots[ i ] ] );
+        }
+    }
+
+    /**
+    * @brief Sorts every column of a table in place with one plan
+    *
+    * The columns are done one after another, so each pass only has
+    * one column's blocks in the cache
+    *
+    * @param plan Plan from BuildPermutePlan
+    * @param columns Columns of the table and their staging buffers
+    */
+    template< typename... Ts >
+    void ApplyPermutation( const PermutePlan& plan, const PermuteColumn< Ts >&... columns )
+    {
+        ( ApplyPermutation( plan, columns ), ... );
+    }
+
+    /**
+    * @brief Finds the order that sorts elements by a numeric key, without
+    * moving the elements ( argsort )
+    *
+    * The keys are read once into a packed array of radix key and index and
+    * that array is radix sorted. With a 32 bit key the sort only touches 8
+    * bytes per element, however big the elements are. The order can then be
+    * applied to the data with GatherByKeys, or to every column of a table
+    * with BuildPermutePlan and ApplyPermutation.
+    *
+    * The radix sort is stable, so equal keys keep their order.
+    *
+    * @param data Elements to order, fewer than 2^32. For a table this is the key column
+    * @param order Receives the sorted entries, at least data.size()
+    * @param scratch Buffer the radix passes alternate with, at least data.size()
+    * @param proj Gets the numeric sort key of an element
+    * @throws std::length_error If data has 2^32 elements or more
+    */
+    template< typename T, typename Proj = std::identity >
+        requires RadixSortable< ProjectedKey< T, Proj > >
+    void ArgSort( std::span< const T > data, std::span< SortKey< T, Proj > > order, std::span< SortKey< T, Proj > > scratch, Proj proj = {} )
+    {
+        using Key = ProjectedKey< T, Proj >;
+
+        const std::size_t size = data.size();
+        if ( size > UINT32_MAX )
+        {
+            throw std::length_error( "ArgSort indexes are 32 bit, too many elements.\n" );
+        }
+
+        for ( std::size_t i = 0; i < size; ++i )
+        {
+            order[ i ] = { ToRadixKey< Key >( std::invoke( proj, data[ i ] ) ), static_cast< std::uint32_t >( i ) };
+        }
+
+        RadixSortBy( order.first( size ), scratch.first( size ), []( const SortKey< T, Proj >& entry ) { return entry.key; } );
+    }
+
+    /**
+    * @brief Sorts elements by a numeric key, without comparing the elements
+    *
+    * Sorting records with QuickSort and a projection reads the key out of
+    * every record on every compare and moves whole records on every swap.
+    * Here the order is found with ArgSort, then each record is gathered once
+    * into scratch and moved back.
+    *
+    * @param data Elements to sort, fewer than 2^32
+    * @param scratch Buffer the elements are gathered into, at least data.size()
+    * @param keys Buffer for the packed keys, at least data.size()
+    * @param keyScratch Buffer the radix passes alternate with, at least data.size()
+    * @param proj Gets the numeric sort key of an element
+    * @throws std::length_error If data has 2^32 elements or more
+    */
+    template< typename T, typename Proj = std::identity >
+        requires RadixSortable< ProjectedKey< T, Proj > >
+    void SortByKey( std::span< T > data, std::span< T > scratch, std::span< SortKey< T, Proj > > keys,
+                    std::span< SortKey< T, Proj > > keyScratch, Proj proj = {} )
+    {
+        const std::size_t size = data.size();
+        if ( size < 2 )
+        {
+            return;
+        }
+
+        ArgSort( std::span< const T >( data ), keys, keyScratch, proj );
+        GatherByKeys( std::span< const SortKey< T, Proj > >( keys.first( size ) ), data, scratch );
+        std::move( scratch.begin(), scratch.begin() + size, data.begin() );
+    }
+}
+
+
+#endif // !SORTCORES_HPP
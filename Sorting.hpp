@@ -1,18 +1,51 @@
 #include "ClassBase.hpp"
+#include "ThreadPool.hpp"
+#include "SortCores.hpp"
+#include "ExternalSort.hpp"
+#include "StreamingTopK.hpp"
+#include <ostream>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <functional>
+
+
+/**
+* @brief Settings for the size scaling sweep
+*/
+struct SweepConfig
+{
+    std::size_t minSize = 1024; //< First size, rounded up to a power of two
+    std::size_t maxSize = 100'000'000; //< Last size, this is included even if not a power of two
+    std::size_t runs = 5; //< Timed runs per size
+    std::size_t warmup = 1; //< Untimed warmup runs per size
+    double budgetUs = 1'000'000.0; //< Once a sorts median run passes this, larger sizes are skipped
+    Distribution distribution = Distribution::Uniform; //< Shape of the generated arrays
+};
 
 /**
 * @brief Class implementing various sorting algorithms
 *
 * Contains implementations of common sorting algorithms including
-* Bubble Sort, Selection Sort, Insertion Sort, Quick Sort, and Merge Sort.
+* Bubble Sort, Selection Sort, Insertion Sort, Quick Sort ( introsort ), and Merge Sort.
+* When only the smallest k are needed SortCores also has partial sort,
+* nth element and top k, BenchmarkSelection compares them to a full sort.
 * This class handles the performance measurements as well.
 *
+* The sorts themselves live in SortCores and work on any span, this class
+* runs them on its own array and adds the printing and timing. SortCores
+* also sorts any type by a comparator and projection, BenchmarkKeySort
+* shows that on records sorted by a key field, and BenchmarkColumnSort
+* sorts the same kind of table stored as columns.
+*
 * @tparam T Numeric type that meets the NumericConstraint requirement
 */
 template <typename T>
     requires NumericConstraint<T>
 class SortingAlgorithms: public AlgorithmsBase<T>
 {
+private:
+    std::unique_ptr<ThreadPool> pool; //< Pool for the parallel sorts, made on first use
 
 public:
     /**
@@ -37,8 +70,679 @@ public:
         MergeSortInit();
     }
 
+    /**
+    * @brief Benchmarks all sorting algorithms with repeated runs
+    *
+    * Every algorithm sorts a copy of the same input, the copy
+    * is restored before each run and is not timed
+    *
+    * @param runs Number of timed runs per algorithm
+    * @param warmup Number of untimed warmup runs per algorithm
+    */
+    void BenchmarkAllAlgorithms( const std::size_t runs = 15, const std::size_t warmup = 3 )
+    {
+        this->InitArray();
+
+        // Edge case check
+        if ( this->szArray == 0 || this->szArray == 1 )
+        {
+            return;
+        }
+
+        /// Copy of the input so each run sorts the same data
+        const std::vector<T> source = this->array;
+        this->tempBuffer.resize( this->szArray );
+
+        BenchmarkRunner runner( warmup, runs );
+        for ( const auto& [ name, core ] : GetSortCores() )
+        {
+            BenchmarkRunner::PrintStats( std::string( name ), BenchSortCore( runner, source, core ) );
+        }
+    }
+
+    /**
+    * @brief Runs every sort over power of two sizes and
+    * prints the results as CSV
+    *
+    * Each size gets a new random array, every sort gets a copy
+    * of that same array. Once a sort's median run goes over the time
+    * budget it is skipped for the larger sizes, this is how the
+    * quadratic sorts drop out of the sweep.
+    *
+    * @param out Stream to write the CSV to
+    * @param config Sizes, runs and time budget for the sweep
+    */
+    void SweepAllAlgorithms( std::ostream& out = std::cout, const SweepConfig& config = SweepConfig() )
+    {
+        const auto& cores = GetSortCores();
+
+        /// Sorts that are still under the time budget
+        std::array<bool, std::tuple_size_v< std::remove_cvref_t< decltype( cores ) > >> active;
+        active.fill( true );
+
+        BenchmarkRunner runner( config.warmup, config.runs );
+        const Distribution oldDistribution = this->GetDistribution();
+        this->SetDistribution( config.distribution );
+
+        BenchmarkRunner::PrintCsvHeader( out );
+        for ( const std::size_t size : GetSweepSizes( config ) )
+        {
+            this->InitArray( size );
+            const std::vector<T> source = this->array;
+            this->tempBuffer.resize( size );
+
+            for ( std::size_t i = 0; i < cores.size(); ++i )
+            {
+                if ( !active[ i ] )
+                {
+                    continue;
+                }
+
+                const BenchStats stats = BenchSortCore( runner, source, cores[ i ].second );
+                BenchmarkRunner::PrintCsvRow( out, GetDistributionName( config.distribution ), cores[ i ].first, stats );
+
+                active[ i ] = stats.medianUs <= config.budgetUs;
+            }
+        }
+        this->SetDistribution( oldDistribution );
+    }
+
+    /**
+    * @brief Runs every sort over every input distribution
+    * and prints the results as CSV
+    *
+    * @note Bubble, selection and insertion sort are quadratic,
+    * so keep the size small
+    *
+    * @param size Number of elements in each array
+    * @param out Stream to write the CSV to
+    * @param runs Number of timed runs per sort
+    * @param warmup Number of untimed warmup runs per sort
+    */
+    void BenchmarkAllDistributions( const std::size_t size = 10'000, std::ostream& out = std::cout,
+                                    const std::size_t runs = 5, const std::size_t warmup = 1 )
+    {
+        const Distribution oldDistribution = this->GetDistribution();
+        BenchmarkRunner runner( warmup, runs );
+
+        BenchmarkRunner::PrintCsvHeader( out );
+        for ( const Distribution dist : allDistributions )
+        {
+            this->SetDistribution( dist );
+            this->InitArray( size );
+            const std::vector<T> source = this->array;
+            this->tempBuffer.resize( size );
+
+            for ( const auto& [ name, core ] : GetSortCores() )
+            {
+                BenchmarkRunner::PrintCsvRow( out, GetDistributionName( dist ), name, BenchSortCore( runner, source, core ) );
+            }
+        }
+        this->SetDistribution( oldDistribution );
+    }
+
+    /**
+    * @brief Sets the number of threads the parallel sorts use
+    *
+    * @param threads Number of worker threads
+    */
+    void SetThreadCount( const std::size_t threads )
+    {
+        pool = std::make_unique<ThreadPool>( threads );
+    }
+
+    /**
+    * @brief Benchmarks the parallel merge sort at 1, 2, 4 ... threads
+    * up to the core count and prints the speedup curve as CSV
+    *
+    * Speedup is against the single thread run of the same sort, the
+    * bottom up merge sort is included as the sequential baseline
+    *
+    * @param size Number of elements to sort
+    * @param out Stream to write the CSV to
+    * @param runs Number of timed runs per thread count
+    * @param warmup Number of untimed warmup runs per thread count
+    */
+    void BenchmarkParallelSpeedup( const std::size_t size = 1 << 24, std::ostream& out = std::cout,
+                                   const std::size_t runs = 5, const std::size_t warmup = 1 )
+    {
+        this->InitArray( size );
+        const std::vector<T> source = this->array;
+        this->tempBuffer.resize( size );
+
+        BenchmarkRunner runner( warmup, runs );
+        const BenchStats sequential = BenchSortCore( runner, source, &SortingAlgorithms::BottomUpMergeSortCore );
+
+        /// 1, 2, 4 ... and the core count itself if that isn't a power of two
+        const std::size_t maxThreads = std::max< std::size_t >( std::thread::hardware_concurrency(), 1 );
+        std::vector<std::size_t> threadCounts;
+        for ( std::size_t threads = 1; threads < maxThreads; threads *= 2 )
+        {
+            threadCounts.push_back( threads );
+        }
+        threadCounts.push_back( maxThreads );
+
+        std::println( out, "threads,size,median_us,speedup,speedup_vs_sequential" );
+        double singleThreadUs = 0.0;
+        for ( const std::size_t threads : threadCounts )
+        {
+            SetThreadCount( threads );
+            const BenchStats stats = BenchSortCore( runner, source, &SortingAlgorithms::ParallelMergeSortCore );
+            if ( threads == 1 )
+            {
+                singleThreadUs = stats.medianUs;
+            }
+
+            std::println( out, "{},{},{:.3f},{:.3f},{:.3f}", threads, size, stats.medianUs,
+                          singleThreadUs / stats.medianUs, sequential.medianUs / stats.medianUs );
+        }
+
+        /// Back to one thread per core
+        pool.reset();
+    }
+
+    /**
+    * @brief Benchmarks the selection algorithms against a full quick sort
+    * for a range of k and prints the results as CSV
+    *
+    * For each k the partial sort, nth element, top k heap and streaming
+    * top k all find the k smallest, std::partial_sort is the baseline. The
+    * input is restored from a copy before each run, the full sort is
+    * timed once and every row's speedup is against it.
+    *
+    * @param size Number of elements to select from
+    * @param out Stream to write the CSV to
+    * @param runs Number of timed runs per algorithm and k
+    * @param warmup Number of untimed warmup runs per algorithm and k
+    */
+    void BenchmarkSelection( const std::size_t size = 1 << 24, std::ostream& out = std::cout,
+                             const std::size_t runs = 5, const std::size_t warmup = 1 )
+    {
+        this->InitArray( size );
+        const std::vector<T> source = this->array;
+
+        BenchmarkRunner runner( warmup, runs );
+        const BenchStats fullSort = BenchSortCore( runner, source, &SortingAlgorithms::QuickSortCore );
+
+        std::println( out, "size,k,algorithm,median_us,speedup_vs_quick_sort" );
+        std::println( out, "{},{},{},{:.3f},{:.3f}", size, size, "Quick Sort", fullSort.medianUs, 1.0 );
+
+        for ( std::size_t k = 1; k <= size / 10; k *= 10 )
+        {
+            std::vector<T> best( k );
+            StreamingTopK<T> stream( k );
+
+            const std::pair<std::string_view, std::function<void()>> selects[] =
+            {
+                { "Partial Sort", [ & ]() { SortCores::PartialSort( this->view, k ); } },
+                { "Nth Element", [ & ]() { SortCores::NthElement( this->view, k - 1 ); } },
+                { "Top K Heap", [ & ]() { SortCores::TopK( std::span<const T>( this->view ), std::span<T>( best ) ); } },
+                { "Streaming Top K", [ & ]()
+                {
+                    stream.Clear();
+                    for ( std::size_t first = 0; first < size; first += STREAM_CHUNK_SIZE )
+                    {
+                        stream.Push( std::span<const T>( this->view ).subspan( first, std::min( STREAM_CHUNK_SIZE, size - first ) ) );
+                    }
+                    stream.Sorted( std::span<T>( best ) );
+                } },
+                { "Std Partial Sort", [ & ]() { std::partial_sort( this->view.begin(), this->view.begin() + k, this->view.end() ); } },
+            };
+
+            for ( const auto& [ name, select ] : selects )
+            {
+                const BenchStats stats = runner.Run( size, [ & ]()
+                {
+                    std::ranges::copy( source, this->view.begin() );
+                }, [ & ]()
+                {
+                    select();
+                    DoNotOptimize( this->view.data() );
+                    DoNotOptimize( best.data() );
+                } );
+                std::println( out, "{},{},{},{:.3f},{:.3f}", size, k, name, stats.medianUs, fullSort.medianUs / stats.medianUs );
+            }
+        }
+    }
+
+    /**
+    * @brief Benchmarks sorting cache line sized records by a T key
+    * field and prints the results as CSV
+    *
+    * The comparison sorts get the key through a projection, so every
+    * compare reads a record and every swap moves 64 bytes. The key sort
+    * sorts packed key and index pairs and moves each record twice, once
+    * into scratch and once back.
+    *
+    * @param size Number of records to sort
+    * @param out Stream to write the CSV to
+    * @param runs Number of timed runs per sort
+    * @param warmup Number of untimed warmup runs per sort
+    */
+    void BenchmarkKeySort( const std::size_t size = 1 << 22, std::ostream& out = std::cout,
+                           const std::size_t runs = 5, const std::size_t warmup = 1 )
+        requires SortCores::RadixSortable<T>
+    {
+        /// Keys come from the current distribution, the payload just remembers where the record started
+        this->InitArray( size );
+        std::vector<KeyedRecord> source( size );
+        for ( std::size_t i = 0; i < size; ++i )
+        {
+            source[ i ].key = this->array[ i ];
+            source[ i ].payload[ 0 ] = static_cast< std::uint32_t >( i );
+        }
+        this->ResetArray();
+
+        std::vector<KeyedRecord> records( size );
+        std::vector<KeyedRecord> scratch( size );
+        using RecordKey = SortCores::SortKey<KeyedRecord, decltype( &KeyedRecord::key )>;
+        std::vector<RecordKey> keys( size );
+        std::vector<RecordKey> keyScratch( size );
+
+        const std::span<KeyedRecord> data( records );
+        const std::pair<std::string_view, std::function<void()>> sorts[] =
+        {
+            { "Quick Sort By Key", [ & ]() { SortCores::QuickSort( data, {}, &KeyedRecord::key ); } },
+            { "Bottom Up Merge Sort By Key", [ & ]() { SortCores::BottomUpMergeSort( data, std::span<KeyedRecord>( scratch ), {}, &KeyedRecord::key ); } },
+            { "Std Sort By Key", [ & ]() { std::ranges::sort( data, {}, &KeyedRecord::key ); } },
+            { "Packed Key Sort", [ & ]()
+            {
+                SortCores::SortByKey( data, std::span<KeyedRecord>( scratch ), std::span<RecordKey>( keys ), std::span<RecordKey>( keyScratch ), &KeyedRecord::key );
+            } },
+        };
+
+        BenchmarkRunner runner( warmup, runs );
+        BenchmarkRunner::PrintCsvHeader( out );
+        for ( const auto& [ name, sort ] : sorts )
+        {
+            const BenchStats stats = runner.Run( size, [ & ]()
+            {
+                std::ranges::copy( source, records.begin() );
+            }, [ & ]()
+            {
+                sort();
+                DoNotOptimize( records.data() );
+            } );
+            BenchmarkRunner::PrintCsvRow( out, GetDistributionName( this->GetDistribution() ), name, stats );
+        }
+    }
+
+    /**
+    * @brief Benchmarks sorting a table by a T key column and
+    * prints the results as CSV
+    *
+    * The same table is sorted two ways. As an array of records, with
+    * std::ranges::sort and with the packed key sort. As separate columns,
+    * with ArgSort on the key column and then either a gather of each column
+    * or one BuildPermutePlan applied to every column. The plan only pays
+    * off once the columns are bigger than the cache.
+    *
+    * @param size Number of rows in the table
+    * @param out Stream to write the CSV to
+    * @param runs Number of timed runs per sort
+    * @param warmup Number of untimed warmup runs per sort
+    */
+    void BenchmarkColumnSort( const std::size_t size = 1 << 22, std::ostream& out = std::cout,
+                              const std::size_t runs = 5, const std::size_t warmup = 1 )
+        requires SortCores::RadixSortable<T>
+    {
+        this->InitArray( size );
+        std::vector<TableRow> sourceRows( size );
+        for ( std::size_t i = 0; i < size; ++i )
+        {
+            sourceRows[ i ] = { this->array[ i ], static_cast< double >( i ), i, static_cast< std::uint32_t >( i ) };
+        }
+        this->ResetArray();
+
+        /// Array of records layout
+        std::vector<TableRow> rows( size ), rowScratch( size );
+        using RowKey = SortCores::SortKey<TableRow, decltype( &TableRow::key )>;
+        std::vector<RowKey> rowOrder( size ), rowOrderScratch( size );
+
+        /// Column layout, each column has a buffer to be gathered or staged into
+        std::vector<T> keys( size ), keyScratch( size );
+        std::vector<double> prices( size ), priceScratch( size );
+        std::vector<std::uint64_t> ids( size ), idScratch( size );
+        std::vector<std::uint32_t> quantities( size ), quantityScratch( size );
+        using ColumnKey = SortCores::SortKey<T, std::identity>;
+        std::vector<ColumnKey> order( size ), orderScratch( size );
+        std::vector<std::uint32_t> planSources( size ), planSlots( size );
+        std::vector<std::uint32_t> planCursors( SortCores::PermutePlanBlocks( size ) );
+
+        const auto sortOrder = [ & ]()
+        {
+            SortCores::ArgSort( std::span<const T>( keys ), std::span<ColumnKey>( order ), std::span<ColumnKey>( orderScratch ) );
+            return std::span<const ColumnKey>( order );
+        };
+
+        const std::pair<std::string_view, std::function<void()>> sorts[] =
+        {
+            { "Record Std Sort By Key", [ & ]() { std::ranges::sort( rows, {}, &TableRow::key ); } },
+            { "Record Packed Key Sort", [ & ]()
+            {
+                SortCores::SortByKey( std::span<TableRow>( rows ), std::span<TableRow>( rowScratch ),
+                                      std::span<RowKey>( rowOrder ), std::span<RowKey>( rowOrderScratch ), &TableRow::key );
+            } },
+            { "Column Argsort Gather", [ & ]()
+            {
+                const auto sorted = sortOrder();
+                SortCores::GatherByKeys( sorted, std::span<T>( keys ), std::span<T>( keyScratch ) );
+                SortCores::GatherByKeys( sorted, std::span<double>( prices ), std::span<double>( priceScratch ) );
+                SortCores::GatherByKeys( sorted, std::span<std::uint64_t>( ids ), std::span<std::uint64_t>( idScratch ) );
+                SortCores::GatherByKeys( sorted, std::span<std::uint32_t>( quantities ), std::span<std::uint32_t>( quantityScratch ) );
+            } },
+            { "Column Argsort Blocked", [ & ]()
+            {
+                const auto plan = SortCores::BuildPermutePlan( sortOrder(), std::span<std::uint32_t>( planSources ),
+                                                               std::span<std::uint32_t>( planSlots ), std::span<std::uint32_t>( planCursors ) );
+                SortCores::ApplyPermutation( plan, SortCores::PermuteColumn<T>{ keys, keyScratch },
+                                             SortCores::PermuteColumn<double>{ prices, priceScratch },
+                                             SortCores::PermuteColumn<std::uint64_t>{ ids, idScratch },
+                                             SortCores::PermuteColumn<std::uint32_t>{ quantities, quantityScratch } );
+            } },
+        };
+
+        BenchmarkRunner runner( warmup, runs );
+        BenchmarkRunner::PrintCsvHeader( out );
+        for ( const auto& [ name, sort ] : sorts )
+        {
+            const BenchStats stats = runner.Run( size, [ & ]()
+            {
+                std::ranges::copy( sourceRows, rows.begin() );
+                for ( std::size_t i = 0; i < size; ++i )
+                {
+                    keys[ i ] = sourceRows[ i ].key;
+                    prices[ i ] = sourceRows[ i ].price;
+                    ids[ i ] = sourceRows[ i ].id;
+                    quantities[ i ] = sourceRows[ i ].quantity;
+                }
+            }, [ & ]()
+            {
+                sort();
+                DoNotOptimize( rows.data() );
+                DoNotOptimize( keys.data() );
+                DoNotOptimize( keyScratch.data() );
+            } );
+            BenchmarkRunner::PrintCsvRow( out, GetDistributionName( this->GetDistribution() ), name, stats );
+        }
+    }
+
+    /**
+    * @brief Runs every sort on a binary file of T and prints the results as CSV
+    *
+    * The file is mapped copy on write with LoadArray, so the sorts run on
+    * the mapped pages and the file itself is never changed. The input is
+    * restored from a copy before each run. Bubble, selection and insertion
+    * sort are skipped for files over QUADRATIC_SORT_MAX_SIZE elements.
+    *
+    * @param path File of raw T values
+    * @param out Stream to write the CSV to, the file name goes in the distribution column
+    * @param runs Number of timed runs per sort
+    * @param warmup Number of untimed warmup runs per sort
+    * @throws std::runtime_error If the file can't be opened or mapped
+    */
+    void BenchmarkFile( const std::filesystem::path& path, std::ostream& out = std::cout,
+                        const std::size_t runs = 5, const std::size_t warmup = 1 )
+    {
+        this->LoadArray( path, MapMode::CopyOnWrite, AccessHint::Sequential );
+        if ( this->szArray < 2 )
+        {
+            return;
+        }
+
+        const std::vector<T> source( this->view.begin(), this->view.end() );
+        this->tempBuffer.resize( this->szArray );
+        const std::string fileName = path.filename().string();
+
+        BenchmarkRunner runner( warmup, runs );
+        BenchmarkRunner::PrintCsvHeader( out );
+        for ( const auto& [ name, core ] : GetSortCores() )
+        {
+            const bool quadratic = core == &SortingAlgorithms::BubbleSortCore || core == &SortingAlgorithms::SelectionSortCore ||
+                core == &SortingAlgorithms::InsertionSortCore;
+            if ( quadratic && this->szArray > QUADRATIC_SORT_MAX_SIZE )
+            {
+                continue;
+            }
+
+            BenchmarkRunner::PrintCsvRow( out, fileName, name, BenchSortCore( runner, source, core ) );
+        }
+    }
+
+    /**
+    * @brief Sorts a binary file of T that can be larger than memory
+    *
+    * The input is read a run at a time into the array, each run is radix
+    * sorted and spilled to a temp file. The runs are then merged with a loser
+    * tree, fanIn runs at a time, until one merge writes the output. Each pass
+    * reads and writes the whole data set once, so with 1GB of memory and 4MB
+    * buffers a single merge pass covers about 255GB of input.
+    *
+    * Reads and writes go through large buffers so every run is read in big
+    * sequential blocks no matter how the merge interleaves them.
+    *
+    * @note The array and tempBuffer are used for the runs and cleared afterwards
+    *
+    * @param input File of raw T values, its size must be a multiple of sizeof( T )
+    * @param output File to write the sorted values to, must not be input
+    * @param config Memory budget, buffer size and temp directory
+    * @return Number of sorted runs the input was split into
+    * @throws std::runtime_error If a file can't be opened, read or written
+    */
+    std::size_t ExternalSort( const std::filesystem::path& input, const std::filesystem::path& output,
+                              const ExternalSortConfig& config = ExternalSortConfig() )
+    {
+        /// Array and tempBuffer share the memory budget
+        const std::size_t runElements = std::max< std::size_t >( config.memoryBytes / ( 2 * sizeof( T ) ), 1 );
+        const std::size_t bufferElements = std::max< std::size_t >( config.bufferBytes / sizeof( T ), 1 );
+        const std::size_t fanIn = std::max< std::size_t >( config.memoryBytes / std::max< std::size_t >( config.bufferBytes, 1 ), 3 ) - 1;
+
+        TempRunFiles temp( config.tempDirectory );
+        std::vector<std::filesystem::path> runs;
+        {
+            std::ifstream file( input, std::ios::binary );
+            if ( !file )
+            {
+                throw std::runtime_error( "Failed to open " + input.string() + " for reading.\n" );
+            }
+
+            this->ResetArray();
+            this->array.resize( runElements );
+            this->tempBuffer.resize( runElements );
+
+            std::size_t count = 0;
+            while ( ( count = ReadValues( file, this->array.data(), runElements ) ) > 0 )
+            {
+                this->array.resize( count );
+                this->UseArray();
+                RadixSortCore();
+
+                /// Everything fit in one run, no merge needed
+                if ( runs.empty() && count < runElements )
+                {
+                    RunWriter<T>( output, bufferElements ).Write( this->array.data(), count );
+                    this->ResetArray();
+                    return 1;
+                }
+
+                runs.push_back( temp.NewRun() );
+                RunWriter<T>( runs.back(), bufferElements ).Write( this->array.data(), count );
+                this->array.resize( runElements );
+            }
+        }
+        this->ResetArray();
+
+        if ( runs.empty() )
+        {
+            RunWriter<T>( output, bufferElements ).Flush();
+            return 0;
+        }
+
+        const std::size_t totalRuns = runs.size();
+
+        /// Merge fanIn runs at a time until the last merge fits in one pass
+        while ( runs.size() > fanIn )
+        {
+            std::vector<std::filesystem::path> merged;
+            for ( std::size_t first = 0; first < runs.size(); first += fanIn )
+            {
+                const std::size_t last = std::min( first + fanIn, runs.size() );
+                if ( last - first == 1 )
+                {
+                    merged.push_back( runs[ first ] );
+                    continue;
+                }
+
+                merged.push_back( temp.NewRun() );
+                MergeRuns( std::span( runs ).subspan( first, last - first ), merged.back(), bufferElements );
+                for ( std::size_t i = first; i < last; ++i )
+                {
+                    temp.Remove( runs[ i ] );
+                }
+            }
+            runs.swap( merged );
+        }
+
+        MergeRuns( runs, output, bufferElements );
+        return totalRuns;
+    }
+
+    /**
+    * @brief Benchmarks the external sort on a generated file
+    * and prints the results as CSV
+    *
+    * The file is written once with the current distribution, then
+    * sorted with a small memory budget so it splits into many runs
+    *
+    * @param size Number of elements in the file
+    * @param out Stream to write the CSV to
+    * @param config Memory budget, buffer size and temp directory
+    * @param runs Number of timed runs
+    * @param warmup Number of untimed warmup runs
+    */
+    void BenchmarkExternalSort( const std::size_t size = 1 << 26, std::ostream& out = std::cout,
+                                const ExternalSortConfig& config = { 1 << 26, 1 << 20 },
+                                const std::size_t runs = 3, const std::size_t warmup = 0 )
+    {
+        TempRunFiles files( config.tempDirectory );
+        const std::filesystem::path input = files.NewRun();
+        const std::filesystem::path output = files.NewRun();
+
+        this->InitArray( size );
+        RunWriter<T>( input, 1 ).Write( this->array.data(), size );
+        this->ResetArray();
+
+        std::size_t runCount = 0;
+        BenchmarkRunner runner( warmup, runs );
+        const BenchStats stats = runner.Run( size, []() {}, [ & ]()
+        {
+            runCount = ExternalSort( input, output, config );
+        } );
+
+        const double megabytes = static_cast< double >( size * sizeof( T ) ) / ( 1024.0 * 1024.0 );
+        std::println( out, "size,memory_bytes,buffer_bytes,runs,median_us,mb_per_sec" );
+        std::println( out, "{},{},{},{},{:.3f},{:.3f}", size, config.memoryBytes, config.bufferBytes,
+                      runCount, stats.medianUs, megabytes / ( stats.medianUs / 1'000'000.0 ) );
+    }
+
 private:
 
+    /// Pointer to one of our sort cores
+    using SortCore = void ( SortingAlgorithms::* )();
+
+    /// Largest file BenchmarkFile runs the quadratic sorts on
+    static constexpr std::size_t QUADRATIC_SORT_MAX_SIZE = 1 << 16;
+    /// Samples BenchmarkSelection feeds the streaming top k at a time
+    static constexpr std::size_t STREAM_CHUNK_SIZE = 1 << 12;
+
+    /**
+    * @brief Record the key sort benchmark sorts, a key
+    * and enough payload to fill a cache line
+    */
+    struct KeyedRecord
+    {
+        T key; //< What the records are sorted by
+        std::array<std::uint32_t, ( 64 - sizeof( T ) ) / sizeof( std::uint32_t )> payload; //< Stand in for the other fields
+    };
+
+    /**
+    * @brief Row of the table the column sort benchmark sorts, as one record
+    */
+    struct TableRow
+    {
+        T key; //< What the rows are sorted by
+        double price; //< Payload column
+        std::uint64_t id; //< Payload column
+        std::uint32_t quantity; //< Payload column
+    };
+
+    /**
+    * @brief Gets the name and core of every sort,
+    * this is what the benchmarks and sweep loop over
+    *
+    * @return Array of name, core pairs
+    */
+    static const auto& GetSortCores()
+    {
+        static const std::array<std::pair<std::string_view, SortCore>, 9> cores =
+        { {
+            { "Bubble Sort", &SortingAlgorithms::BubbleSortCore },
+            { "Selection Sort", &SortingAlgorithms::SelectionSortCore },
+            { "Insertion Sort", &SortingAlgorithms::InsertionSortCore },
+            { "Quick Sort", &SortingAlgorithms::QuickSortCore },
+            { "Merge Sort", &SortingAlgorithms::MergeSortCore },
+            { "Bottom Up Merge Sort", &SortingAlgorithms::BottomUpMergeSortCore },
+            { "Parallel Merge Sort", &SortingAlgorithms::ParallelMergeSortCore },
+            { "Radix Sort", &SortingAlgorithms::RadixSortCore },
+            { "Std Sort", &SortingAlgorithms::StdSortCore },
+        } };
+        return cores;
+    }
+
+    /**
+    * @brief Gets the power of two sizes for the sweep
+    *
+    * @param config Sweep settings
+    * @return Sizes in increasing order
+    */
+    static std::vector<std::size_t> GetSweepSizes( const SweepConfig& config )
+    {
+        const std::size_t maxSize = config.maxSize;
+
+        std::vector<std::size_t> sizes;
+        for ( std::size_t size = std::bit_ceil( std::max< std::size_t >( config.minSize, 2 ) ); size <= maxSize; size <<= 1 )
+        {
+            sizes.push_back( size );
+        }
+
+        if ( sizes.empty() || sizes.back() != maxSize )
+        {
+            sizes.push_back( maxSize );
+        }
+        return sizes;
+    }
+
+    /**
+    * @brief Benchmarks one sort core, restoring the
+    * array from source before each run
+    *
+    * @param runner Runner to use for the benchmark
+    * @param source The unsorted input
+    * @param core The sort to run
+    * @return Statistics for the runs
+    */
+    BenchStats BenchSortCore( BenchmarkRunner& runner, const std::vector<T>& source, const SortCore core )
+    {
+        return runner.Run( source.size(), [ & ]()
+        {
+            std::ranges::copy( source, this->view.begin() );
+        }, [ & ]()
+        {
+            ( this->*core )();
+            DoNotOptimize( this->view.data() );
+        } );
+    }
+
     /**
     * @brief Bubble Sort algorithm
     */
@@ -61,17 +765,7 @@ private:
         this->timer.Start();
 
         /// Sort array
-        for ( T i = 0; i < this->szArray - 1; ++i )
-        {
-            for ( T j = 0; j < this->szArray - i - 1; ++j )
-            {
-                if ( this->array[ j ] > this->array[ j + 1 ] )
-                {
-                    this->XorSwap( this->array[ j ], this->array[ j + 1 ] );
-                }
-            }
-
-        }
+        BubbleSortCore();
 
         /// End Timer
         this->timer.Stop();
@@ -111,26 +805,7 @@ private:
         this->timer.Start();
 
         /// Sort array
-        T minValueIndex = 0;
-        for ( T i = 0; i < this->szArray - 1; ++i )
-        {
-            /// Reset minValueIndex
-            minValueIndex = i;
-
-            /// Iterate through unsorted portion
-            for ( T j = i + 1; j < this->szArray; ++j )
-            {
-                if ( this->array[ j ] <= this->array[ minValueIndex ] )
-                {
-                    minValueIndex = j;
-                }
-            }
-            if ( minValueIndex != i )
-            {
-                /// Make swap
-                this->XorSwap( this->array[ i ], this->array[ minValueIndex ] );
-            }
-        }
+        SelectionSortCore();
 
         /// End Timer
         this->timer.Stop();
@@ -168,20 +843,8 @@ private:
         /// Start Timer
         this->timer.Start();
 
-        T j;
-        T comparand;
-        for ( T i = 1; i <= this->szArray - 1; ++i )
-        {
-            comparand = this->array[ i ];
-            j = i - 1;
-            while ( j >= 0 && this->array[ j ] > comparand )
-            {
-                this->array[ j + 1 ] = this->array[ j ];
-                --j;
-            }
-
-            this->array[ j + 1 ] = comparand;
-        }
+        /// Sort array
+        InsertionSortCore();
 
         /// End this->timer
         this->timer.Stop();
@@ -198,51 +861,6 @@ private:
         std::cout << "\n\n";
     }
 
-
-
-    ///-------------Quick-Sort-Start-----------------///
-
-
-    /**
-    * @brief Actual sorting function inside quick sort
-    *
-    * @param pLow Lower index of the partition
-    * @param pHigh Higher index of the partition
-    * @return Pivot position after partitioning
-    */
-    T QuickPartition( T pLow, T pHigh )
-    {
-        T i = pLow - 1;
-
-        for ( T j = pLow; j < pHigh; ++j )
-        {
-            if ( this->array[ j ] <= this->array[ pHigh ] )
-            {
-                this->XorSwap( this->array[ j ], this->array[ ++i ] );
-            }
-        }
-
-        this->XorSwap( this->array[ ++i ], this->array[ pHigh ] );
-
-        return i;
-    }
-
-    /**
-    * @brief Main recursion function for Quick Sort
-    *
-    * @param pLow Lower index of the array segment to sort
-    * @param pHigh Higher index of the array segment to sort
-    */
-    void QuickSort( T pLow, T pHigh )
-    {
-        if ( pLow < pHigh )
-        {
-            T pIndex = QuickPartition( pLow, pHigh );
-            QuickSort( pLow, pIndex - 1 );
-            QuickSort( pIndex + 1, pHigh );
-        }
-    }
-
     /**
     * @brief Main function to call for quick sort
     */
@@ -261,16 +879,11 @@ private:
 
         this->PrintArray();
 
-        /// Setup piviot high low
-        const T pHigh = this->szArray - 1;
-        const T pLow = 0;
-
-
         /// Start Timer
         this->timer.Start();
 
         /// Sort array
-        QuickSort( pLow, pHigh );
+        QuickSortCore();
 
         /// End Timer
         this->timer.Stop();
@@ -287,8 +900,6 @@ private:
         std::cout << "\n\n";
     }
 
-    ///---------------Merge-Sort-Start---------------///
-
     /**
     * @brief Initializes and executes the Merge Sort algorithm
     */
@@ -314,7 +925,7 @@ private:
         this->timer.Start();
 
         /// Call the traditional merge sort
-        MergeSort( 0, this->szArray - 1 );
+        MergeSortCore();
 
         /// End Timer
         this->timer.Stop();
@@ -331,67 +942,127 @@ private:
         std::cout << "\n\n";
     }
 
+    ///-------------Sort-Cores-----------------///
+
     /**
-    * @brief Recursive Merge Sort implementation
-    *
-    * @param start Starting index of the array segment to sort
-    * @param end Ending index of the array segment to sort
+    * @brief Bubble sort on the current array, no printing or timing
     */
-    void MergeSort( T start, T end )
+    void BubbleSortCore()
     {
-        /// Base case: if the subarray has 0 or 1 element, it's already sorted
-        if ( start >= end ) return;
+        SortCores::BubbleSort( this->view );
+    }
 
-        /// Calculate the middle point to divide the array into two halves
-        const T mid = std::midpoint( start, end );
+    /**
+    * @brief Selection sort on the current array, no printing or timing
+    */
+    void SelectionSortCore()
+    {
+        SortCores::SelectionSort( this->view );
+    }
 
-        /// Recursively sort the first half
-        MergeSort( start, mid );
+    /**
+    * @brief Insertion sort on the current array, no printing or timing
+    */
+    void InsertionSortCore()
+    {
+        SortCores::InsertionSort( this->view );
+    }
 
-        /// Recursively sort the second half
-        MergeSort( mid + 1, end );
+    /**
+    * @brief Quick sort on the current array, no printing or timing
+    */
+    void QuickSortCore()
+    {
+        SortCores::QuickSort( this->view );
+    }
+
+    /**
+    * @brief std::sort on the current array, this is
+    * our baseline for the benchmarks
+    */
+    void StdSortCore()
+    {
+        std::sort( this->view.begin(), this->view.end() );
+    }
+
+    /**
+    * @brief Merge sort on the current array, no printing or timing
+    *
+    * @note tempBuffer must already be the size of the array
+    */
+    void MergeSortCore()
+    {
+        SortCores::MergeSort( this->view, std::span<T>( this->tempBuffer ) );
+    }
+
+    /**
+    * @brief Bottom up merge sort on the current array, no printing or timing
+    *
+    * @note tempBuffer must already be the size of the array
+    */
+    void BottomUpMergeSortCore()
+    {
+        SortCores::BottomUpMergeSort( this->view, std::span<T>( this->tempBuffer ) );
+    }
 
-        /// Merge the sorted halves
-        Merge( start, mid, end );
+    /**
+    * @brief Parallel merge sort on the current array, no printing or timing
+    *
+    * Uses the pool from SetThreadCount, or one thread per core
+    *
+    * @note tempBuffer must already be the size of the array
+    */
+    void ParallelMergeSortCore()
+    {
+        if ( !pool )
+        {
+            pool = std::make_unique<ThreadPool>();
+        }
+        SortCores::ParallelMergeSort( this->view, std::span<T>( this->tempBuffer ), *pool );
     }
 
     /**
-    * @brief Merges two sorted subarrays into a single sorted array
+    * @brief LSD radix sort on the current array, no printing or timing
     *
-    * @param start Starting index of first subarray
-    * @param mid Ending index of first subarray
-    * @param end Ending index of second subarray
+    * Types too wide for a radix key ( long double ) are quick sorted instead
+    *
+    * @note tempBuffer must already be the size of the array
     */
-    void Merge( T start, T mid, T end )
+    void RadixSortCore()
     {
-        /// Copy elements to the temp buffer
-        for ( T i = start; i <= end; i++ )
+        if constexpr ( SortCores::RadixSortable<T> )
+        {
+            SortCores::RadixSort( this->view, std::span<T>( this->tempBuffer ) );
+        } else
         {
-            this->tempBuffer[ i ] = this->array[ i ];
+            SortCores::QuickSort( this->view );
         }
+    }
 
-        /// Initial index of first, second halves
-        T i = start;
-        T j = mid + 1;
-        /// Initial index of merged array
-        T k = start;
+    ///-------------External-Sort-Start-------------///
 
-        /// Merge the two halves back into the original array
-        while ( i <= mid && j <= end )
+    /**
+    * @brief Merges sorted run files into one sorted file with a loser tree
+    *
+    * @param runs The run files to merge, at least one
+    * @param output File to write the merged values to
+    * @param bufferElements Elements buffered per run and for the output
+    */
+    static void MergeRuns( std::span<const std::filesystem::path> runs, const std::filesystem::path& output,
+                           const std::size_t bufferElements )
+    {
+        std::vector<RunReader<T>> readers;
+        readers.reserve( runs.size() );
+        for ( const auto& run : runs )
         {
-            if ( this->tempBuffer[ i ] <= this->tempBuffer[ j ] )
-            {
-                this->array[ k++ ] = this->tempBuffer[ i++ ];
-            } else
-            {
-                this->array[ k++ ] = this->tempBuffer[ j++ ];
-            }
+            readers.emplace_back( run, bufferElements );
         }
 
-        /// Copy remaining elements of the first half, if any
-        while ( i <= mid )
+        RunWriter<T> writer( output, bufferElements );
+        for ( LoserTree<T> tree( readers ); !tree.Done(); tree.Pop() )
         {
-            this->array[ k++ ] = this->tempBuffer[ i++ ];
+            writer.Push( tree.Top() );
         }
+        writer.Flush();
     }
 };
@@ -0,0 +1,373 @@
+#ifndef SORTINGNETWORKS_HPP
+#define SORTINGNETWORKS_HPP
+
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#if defined( __AVX2__ ) || defined( __SSE4_1__ ) || defined( __AVX__ )
+#include <immintrin.h>
+#endif
+
+
+/**
+* @brief Bitonic sorting networks for the small leaf ranges of the sorts
+*
+* A sorting network does the same compare exchanges whatever the data is,
+* so there are no branches to mispredict and each compare exchange on a
+* whole vector is just a min, a max and a blend. Blocks of 8, 16 and 32
+* elements are kept in registers the whole time.
+*
+* The kernel is picked at compile time by element type: 32 bit ints and
+* floats get AVX2 ( 8 lanes ) or SSE4.1 ( 4 lanes ) depending on what we
+* are compiled for, everything else falls back to scalar insertion sort.
+*
+* @note The networks are not stable, which does not matter for plain
+* numbers. Float ranges must not contain NaN.
+*/
+namespace SortingNetworks
+{
+    /// Biggest range SortSmall will take
+    inline constexpr std::size_t MAX_NETWORK_SIZE = 32;
+
+    /**
+    * @brief Works out the blend mask for one compare exchange step
+    *
+    * Lane i is paired with lane i ^ j, in each pair the lane that ends
+    * up with the max gets its bit set.
+    *
+    * @param lanes Lanes per vector
+    * @param k Size of the bitonic sequences being merged
+    * @param j Distance between the paired lanes
+    * @param regAscending Direction of the whole register, used once k >= lanes
+    * @return Mask with a bit set for each lane that takes the max
+    */
+    constexpr int LaneBlendMask( const std::size_t lanes, const std::size_t k, const std::size_t j, const bool regAscending )
+    {
+        int mask = 0;
+        for ( std::size_t i = 0; i < lanes; ++i )
+        {
+            const bool ascending = k < lanes ? ( i & k ) == 0 : regAscending;
+            const bool upper = ( i & j ) != 0;
+            if ( upper == ascending )
+            {
+                mask |= 1 << i;
+            }
+        }
+        return mask;
+    }
+
+    /**
+    * @brief Vector operations the networks are built from, a
+    * type with zero lanes has no SIMD kernel
+    */
+    template< typename T >
+    struct VectorOps
+    {
+        static constexpr std::size_t lanes = 0;
+    };
+
+#if defined( __AVX2__ )
+
+    template<>
+    struct VectorOps< std::int32_t >
+    {
+        using Vec = __m256i;
+        static constexpr std::size_t lanes = 8;
+
+        static Vec Load( const std::int32_t* src ) { return _mm256_loadu_si256( reinterpret_cast< const __m256i* >( src ) ); }
+        static void Store( std::int32_t* dst, const Vec v ) { _mm256_storeu_si256( reinterpret_cast< __m256i* >( dst ), v ); }
+        static Vec Min( const Vec a, const Vec b ) { return _mm256_min_epi32( a, b ); }
+        static Vec Max( const Vec a, const Vec b ) { return _mm256_max_epi32( a, b ); }
+
+        /// Swaps every lane with lane i ^ J
+        template< std::size_t J >
+        static Vec Partner( const Vec v )
+        {
+            if constexpr ( J == 1 )
+            {
+                return _mm256_shuffle_epi32( v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+            } else if constexpr ( J == 2 )
+            {
+                return _mm256_shuffle_epi32( v, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+            } else
+            {
+                return _mm256_permute2x128_si256( v, v, 1 );
+            }
+        }
+
+        /// Takes hi where the mask bit is set, else lo
+        template< int Mask >
+        static Vec Blend( const Vec lo, const Vec hi ) { return _mm256_blend_epi32( lo, hi, Mask ); }
+    };
+
+    template<>
+    struct VectorOps< std::uint32_t > : VectorOps< std::int32_t >
+    {
+        static Vec Load( const std::uint32_t* src ) { return _mm256_loadu_si256( reinterpret_cast< const __m256i* >( src ) ); }
+        static void Store( std::uint32_t* dst, const Vec v ) { _mm256_storeu_si256( reinterpret_cast< __m256i* >( dst ), v ); }
+        static Vec Min( const Vec a, const Vec b ) { return _mm256_min_epu32( a, b ); }
+        static Vec Max( const Vec a, const Vec b ) { return _mm256_max_epu32( a, b ); }
+    };
+
+    template<>
+    struct VectorOps< float >
+    {
+        using Vec = __m256;
+        static constexpr std::size_t lanes = 8;
+
+        static Vec Load( const float* src ) { return _mm256_loadu_ps( src ); }
+        static void Store( float* dst, const Vec v ) { _mm256_storeu_ps( dst, v ); }
+        static Vec Min( const Vec a, const Vec b ) { return _mm256_min_ps( a, b ); }
+        static Vec Max( const Vec a, const Vec b ) { return _mm256_max_ps( a, b ); }
+
+        template< std::size_t J >
+        static Vec Partner( const Vec v )
+        {
+            if constexpr ( J == 1 )
+            {
+                return _mm256_permute_ps( v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+            } else if constexpr ( J == 2 )
+            {
+                return _mm256_permute_ps( v, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+            } else
+            {
+                return _mm256_permute2f128_ps( v, v, 1 );
+            }
+        }
+
+        template< int Mask >
+        static Vec Blend( const Vec lo, const Vec hi ) { return _mm256_blend_ps( lo, hi, Mask ); }
+    };
+
+#elif defined( __SSE4_1__ ) || defined( __AVX__ )
+
+    template<>
+    struct VectorOps< std::int32_t >
+    {
+        using Vec = __m128i;
+        static constexpr std::size_t lanes = 4;
+
+        static Vec Load( const std::int32_t* src ) { return _mm_loadu_si128( reinterpret_cast< const __m128i* >( src ) ); }
+        static void Store( std::int32_t* dst, const Vec v ) { _mm_storeu_si128( reinterpret_cast< __m128i* >( dst ), v ); }
+        static Vec Min( const Vec a, const Vec b ) { return _mm_min_epi32( a, b ); }
+        static Vec Max( const Vec a, const Vec b ) { return _mm_max_epi32( a, b ); }
+
+        template< std::size_t J >
+        static Vec Partner( const Vec v )
+        {
+            if constexpr ( J == 1 )
+            {
+                return _mm_shuffle_epi32( v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+            } else
+            {
+                return _mm_shuffle_epi32( v, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+            }
+        }
+
+        template< int Mask >
+        static Vec Blend( const Vec lo, const Vec hi )
+        {
+            return _mm_castps_si128( _mm_blend_ps( _mm_castsi128_ps( lo ), _mm_castsi128_ps( hi ), Mask ) );
+        }
+    };
+
+    template<>
+    struct VectorOps< std::uint32_t > : VectorOps< std::int32_t >
+    {
+        static Vec Load( const std::uint32_t* src ) { return _mm_loadu_si128( reinterpret_cast< const __m128i* >( src ) ); }
+        static void Store( std::uint32_t* dst, const Vec v ) { _mm_storeu_si128( reinterpret_cast< __m128i* >( dst ), v ); }
+        static Vec Min( const Vec a, const Vec b ) { return _mm_min_epu32( a, b ); }
+        static Vec Max( const Vec a, const Vec b ) { return _mm_max_epu32( a, b ); }
+    };
+
+    template<>
+    struct VectorOps< float >
+    {
+        using Vec = __m128;
+        static constexpr std::size_t lanes = 4;
+
+        static Vec Load( const float* src ) { return _mm_loadu_ps( src ); }
+        static void Store( float* dst, const Vec v ) { _mm_storeu_ps( dst, v ); }
+        static Vec Min( const Vec a, const Vec b ) { return _mm_min_ps( a, b ); }
+        static Vec Max( const Vec a, const Vec b ) { return _mm_max_ps( a, b ); }
+
+        template< std::size_t J >
+        static Vec Partner( const Vec v )
+        {
+            if constexpr ( J == 1 )
+            {
+                return _mm_shuffle_ps( v, v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+            } else
+            {
+                return _mm_shuffle_ps( v, v, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+            }
+        }
+
+        template< int Mask >
+        static Vec Blend( const Vec lo, const Vec hi ) { return _mm_blend_ps( lo, hi, Mask ); }
+    };
+
+#endif
+
+    /// True when T has a vector kernel on this build
+    template< typename T >
+    inline constexpr bool hasSimdKernel = VectorOps< T >::lanes > 0;
+
+    /**
+    * @brief One compare exchange step of the bitonic network over
+    * Regs registers, then recurses into the next step
+    *
+    * Pairs closer than a register are handled with a shuffle inside each
+    * register, pairs further apart are whole registers so it is just min
+    * and max. All the loops have constant trip counts and unroll away.
+    *
+    * @tparam Regs Number of registers in the block
+    * @tparam K Size of the bitonic sequences being merged
+    * @tparam J Distance between the paired elements
+    * @param v The registers
+    */
+    template< typename T, std::size_t Regs, std::size_t K, std::size_t J >
+    inline void BitonicStep( typename VectorOps< T >::Vec* v )
+    {
+        using Ops = VectorOps< T >;
+        constexpr std::size_t lanes = Ops::lanes;
+
+        if constexpr ( J >= lanes )
+        {
+            for ( std::size_t r = 0; r < Regs; ++r )
+            {
+                const std::size_t p = r ^ ( J / lanes );
+                if ( r < p )
+                {
+                    const auto lo = Ops::Min( v[ r ], v[ p ] );
+                    const auto hi = Ops::Max( v[ r ], v[ p ] );
+                    const bool ascending = ( ( r * lanes ) & K ) == 0;
+                    v[ r ] = ascending ? lo : hi;
+                    v[ p ] = ascending ? hi : lo;
+                }
+            }
+        } else
+        {
+            for ( std::size_t r = 0; r < Regs; ++r )
+            {
+                const auto partner = Ops::template Partner< J >( v[ r ] );
+                const auto lo = Ops::Min( v[ r ], partner );
+                const auto hi = Ops::Max( v[ r ], partner );
+
+                if ( K < lanes || ( ( r * lanes ) & K ) == 0 )
+                {
+                    v[ r ] = Ops::template Blend< LaneBlendMask( lanes, K, J, true ) >( lo, hi );
+                } else
+                {
+                    v[ r ] = Ops::template Blend< LaneBlendMask( lanes, K, J, false ) >( lo, hi );
+                }
+            }
+        }
+
+        if constexpr ( J > 1 )
+        {
+            BitonicStep< T, Regs, K, J / 2 >( v );
+        } else if constexpr ( K < Regs * lanes )
+        {
+            BitonicStep< T, Regs, K * 2, K >( v );
+        }
+    }
+
+    /**
+    * @brief Sorts exactly Size elements with the vector network
+    *
+    * @tparam Size 8, 16 or 32, must be a multiple of the lane count
+    * @param data The elements to sort
+    */
+    template< typename T, std::size_t Size >
+    inline void SortBlock( T* data )
+    {
+        using Ops = VectorOps< T >;
+        static_assert( hasSimdKernel< T > && Size % Ops::lanes == 0, "no vector network for this block" );
+
+        constexpr std::size_t regs = Size / Ops::lanes;
+        typename Ops::Vec v[ regs ];
+
+        for ( std::size_t r = 0; r < regs; ++r )
+        {
+            v[ r ] = Ops::Load( data + r * Ops::lanes );
+        }
+
+        BitonicStep< T, regs, 2, 1 >( v );
+
+        for ( std::size_t r = 0; r < regs; ++r )
+        {
+            Ops::Store( data + r * Ops::lanes, v[ r ] );
+        }
+    }
+
+    /**
+    * @brief Sorts a small range, the leaf case of the quick and merge sorts
+    *
+    * With a vector kernel the range is copied into a block of 8, 16 or 32,
+    * padded with the biggest value of T so the padding sorts to the end,
+    * then copied back. Full blocks are sorted in place. Without a
+    * kernel this is plain insertion sort.
+    *
+    * @param data First element of the range
+    * @param size Number of elements, at most MAX_NETWORK_SIZE
+    */
+    template< typename T >
+    inline void SortSmall( T* data, const std::size_t size )
+    {
+        if ( size < 2 )
+        {
+            return;
+        }
+
+        if constexpr ( hasSimdKernel< T > )
+        {
+            switch ( size )
+            {
+                case 8: SortBlock< T, 8 >( data ); return;
+                case 16: SortBlock< T, 16 >( data ); return;
+                case 32: SortBlock< T, 32 >( data ); return;
+                default: break;
+            }
+
+            /// Infinity for floats, else max would sort before any infinities in the data
+            constexpr T padding = std::numeric_limits< T >::has_infinity ?
+                std::numeric_limits< T >::infinity() : ( std::numeric_limits< T >::max )();
+
+            const std::size_t blockSize = size < 8 ? 8 : size < 16 ? 16 : 32;
+
+            alignas( 32 ) T block[ MAX_NETWORK_SIZE ];
+            std::copy( data, data + size, block );
+            std::fill( block + size, block + blockSize, padding );
+
+            switch ( blockSize )
+            {
+                case 8: SortBlock< T, 8 >( block ); break;
+                case 16: SortBlock< T, 16 >( block ); break;
+                default: SortBlock< T, 32 >( block ); break;
+            }
+
+            std::copy( block, block + size, data );
+        } else
+        {
+            for ( std::size_t i = 1; i < size; ++i )
+            {
+                const T comparand = data[ i ];
+                std::size_t j = i;
+                while ( j > 0 && comparand < data[ j - 1 ] )
+                {
+                    data[ j ] = data[ j - 1 ];
+                    --j;
+                }
+                data[ j ] = comparand;
+            }
+        }
+    }
+}
+
+
+#endif // !SORTINGNETWORKS_HPP
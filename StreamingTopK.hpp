@@ -0,0 +1,123 @@
+#ifndef STREAMINGTOPK_HPP
+#define STREAMINGTOPK_HPP
+
+
+#include "SortCores.hpp"
+#include <span>
+#include <vector>
+#include <functional>
+
+
+/**
+* @brief The k smallest samples of a stream of any length
+*
+* A max heap of the best k so far, the same heap SortCores::TopK keeps
+* over an array but fed a sample or a chunk at a time. The heap's max is
+* the k-th best seen, a new sample that doesn't beat it is dropped after
+* one compare, so once the heap has settled most samples cost just that.
+*
+* The heap is sized at construction, so memory stays the same no
+* matter how long the stream is.
+*
+* @tparam T Type of the samples
+* @tparam Comp Comparator, a strict weak ordering, greater gives the k largest
+* @tparam Proj Projection applied to samples before comparing
+*/
+template <typename T, typename Comp = std::ranges::less, typename Proj = std::identity>
+class StreamingTopK
+{
+private:
+	std::vector<T> heap; //< Best k so far, max heap, sized once
+	std::size_t count = 0; //< Samples in the heap
+	Comp comp; //< Ordering of the samples
+	Proj proj; //< Gets what is compared from a sample
+
+public:
+	/**
+	* @brief Constructor
+	*
+	* @param k Number of samples to keep, minimum of 1
+	* @param comparator Ordering of the samples
+	* @param projection Gets what is compared from a sample
+	*/
+	explicit StreamingTopK( const std::size_t k, Comp comparator = {}, Proj projection = {} ):
+		heap( std::max< std::size_t >( k, 1 ) ), comp( comparator ), proj( projection ) {}
+
+	/// Number of samples kept, at most Capacity()
+	std::size_t Size() const { return count; }
+	/// The k the stream was made with
+	std::size_t Capacity() const { return heap.size(); }
+	/// True when nothing has been pushed
+	bool Empty() const { return count == 0; }
+
+	/**
+	* @brief Gets the worst sample kept, a new sample has to beat this to get in
+	*
+	* @return The k-th best sample so far, the stream must not be empty
+	*/
+	const T& Threshold() const
+	{
+		return heap[ 0 ];
+	}
+
+	/**
+	* @brief Adds a sample
+	*
+	* @param value The sample
+	*/
+	void Push( const T& value )
+	{
+		const std::span<T> data( heap );
+		if ( count < heap.size() )
+		{
+			heap[ count ] = value;
+			SortCores::HeapSiftUp( data, 0, count, comp, proj );
+			++count;
+		} else if ( SortCores::Before( comp, proj, value, heap[ 0 ] ) )
+		{
+			heap[ 0 ] = value;
+			SortCores::HeapSiftDown( data, 0, 0, count, comp, proj );
+		}
+	}
+
+	/**
+	* @brief Adds a chunk of samples, in order
+	*
+	* @param values The samples
+	*/
+	void Push( std::span<const T> values )
+	{
+		for ( const T& value : values )
+		{
+			Push( value );
+		}
+	}
+
+	/**
+	* @brief Copies the samples kept, best first, the stream is not changed
+	*
+	* @param out Receives the samples, at least Size()
+	* @return Number of samples written
+	*/
+	std::size_t Sorted( std::span<T> out ) const
+	{
+		std::copy( heap.begin(), heap.begin() + count, out.begin() );
+
+		/// The copy is still a valid heap, so only the sort down is needed
+		Comp sortComp = comp;
+		Proj sortProj = proj;
+		SortCores::SortHeap( out, 0, count, sortComp, sortProj );
+		return count;
+	}
+
+	/**
+	* @brief Removes every sample
+	*/
+	void Clear()
+	{
+		count = 0;
+	}
+};
+
+
+#endif // !STREAMINGTOPK_HPP
@@ -0,0 +1,336 @@
+#ifndef STREAMINGWINDOW_HPP
+#define STREAMINGWINDOW_HPP
+
+
+#include "ClassBase.hpp"
+#include <span>
+#include <optional>
+#include <cstdint>
+
+
+/**
+* @brief Fixed capacity ring buffer, the storage behind StreamingWindow
+*
+* Nothing is allocated after construction, pushing onto a full buffer is
+* the callers job to avoid
+*/
+template <typename E>
+class RingBuffer
+{
+private:
+	std::vector<E> slots; //< Storage, sized once
+	std::size_t head = 0; //< Index of the front element
+	std::size_t count = 0; //< Number of elements held
+
+public:
+	/**
+	* @brief Constructor
+	*
+	* @param capacity Most elements the buffer holds, minimum of 1
+	*/
+	explicit RingBuffer( const std::size_t capacity ): slots( std::max< std::size_t >( capacity, 1 ) ) {}
+
+	/// Number of elements held
+	std::size_t Size() const { return count; }
+	/// Most elements the buffer holds
+	std::size_t Capacity() const { return slots.size(); }
+	/// True when nothing is held
+	bool Empty() const { return count == 0; }
+	/// True when another push would overwrite the front
+	bool Full() const { return count == slots.size(); }
+
+	/// Oldest element, the buffer must not be empty
+	const E& Front() const { return slots[ head ]; }
+	/// Newest element, the buffer must not be empty
+	const E& Back() const { return slots[ Wrap( head + count - 1 ) ]; }
+
+	/**
+	* @brief Adds an element after the newest, the buffer must not be full
+	*
+	* @param element Element to add
+	*/
+	void PushBack( const E& element )
+	{
+		slots[ Wrap( head + count ) ] = element;
+		++count;
+	}
+
+	/**
+	* @brief Removes the oldest element, the buffer must not be empty
+	*/
+	void PopFront()
+	{
+		head = Wrap( head + 1 );
+		--count;
+	}
+
+	/**
+	* @brief Removes the newest element, the buffer must not be empty
+	*/
+	void PopBack()
+	{
+		--count;
+	}
+
+	/**
+	* @brief Removes every element
+	*/
+	void Clear()
+	{
+		head = 0;
+		count = 0;
+	}
+
+private:
+	/**
+	* @brief Wraps an index that is at most one lap past the end
+	*
+	* @param index Index to wrap
+	* @return Index into slots
+	*/
+	std::size_t Wrap( const std::size_t index ) const
+	{
+		return index >= slots.size() ? index - slots.size() : index;
+	}
+};
+
+
+/**
+* @brief Running sum, min and max over the most recent samples of a stream
+*
+* The same windowing SlidingWindow does over an array, but fed a chunk at a
+* time from a stream of any length. The window is either the last N samples,
+* or every sample newer than a time span.
+*
+* Min and max come from monotonic deques: the min deque only keeps samples
+* that are smaller than everything after them, so its front is the window
+* min, and each sample goes in and out of it once, O( 1 ) amortized. The sum
+* is updated as samples come in and fall out.
+*
+* All buffers are sized at construction, so memory stays the same no
+* matter how long the stream is.
+*
+* @tparam T Numeric type that meets the NumericConstraint requirement
+*/
+template <typename T>
+	requires NumericConstraint<T>
+class StreamingWindow
+{
+public:
+	/// Sample times, in whatever unit the window length is given in
+	using Timestamp = std::int64_t;
+	/// Type the running sum is kept in, wide enough not to overflow
+	using SumType = std::conditional_t<std::is_floating_point_v<T>, double,
+		std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+
+private:
+	/**
+	* @brief A sample in the window
+	*/
+	struct Sample
+	{
+		T value; //< The sample
+		Timestamp time; //< When it arrived
+		std::uint64_t sequence; //< Position in the stream, tells deque entries apart
+	};
+
+	RingBuffer<Sample> window; //< Samples in the window, oldest first
+	RingBuffer<Sample> minDeque; //< Increasing values, front is the min
+	RingBuffer<Sample> maxDeque; //< Decreasing values, front is the max
+	SumType sum = 0; //< Sum of the window
+	std::uint64_t nextSequence = 0; //< Sequence number of the next sample
+	Timestamp length = 0; //< Time span of the window, 0 for a count window
+
+public:
+	/**
+	* @brief Constructor for a window over the last windowSize samples
+	*
+	* @param windowSize Number of samples in the window, minimum of 1
+	*/
+	explicit StreamingWindow( const std::size_t windowSize ):
+		window( windowSize ), minDeque( windowSize ), maxDeque( windowSize ) {}
+
+	/**
+	* @brief Constructor for a window over every sample newer than windowLength
+	*
+	* @param windowLength Age at which a sample falls out of the window, more than 0
+	* @param maxSamples Most samples kept, if more than this arrive within
+	* windowLength the oldest fall out early
+	*/
+	StreamingWindow( const Timestamp windowLength, const std::size_t maxSamples ):
+		window( maxSamples ), minDeque( maxSamples ), maxDeque( maxSamples ), length( windowLength ) {}
+
+	/**
+	* @brief Adds a sample to a count window
+	*
+	* @param value The sample
+	*/
+	void Push( const T value )
+	{
+		Push( value, static_cast< Timestamp >( nextSequence ) );
+	}
+
+	/**
+	* @brief Adds a sample, expiring anything too old for a time window
+	*
+	* @param value The sample
+	* @param time When it arrived, must not go backwards
+	*/
+	void Push( const T value, const Timestamp time )
+	{
+		AdvanceTo( time );
+		if ( window.Full() )
+		{
+			PopOldest();
+		}
+
+		const Sample sample{ value, time, nextSequence++ };
+		window.PushBack( sample );
+		sum += static_cast< SumType >( value );
+
+		/// Anything not smaller than the new sample can never be the min again, same for max
+		while ( !minDeque.Empty() && !( minDeque.Back().value < value ) )
+		{
+			minDeque.PopBack();
+		}
+		minDeque.PushBack( sample );
+
+		while ( !maxDeque.Empty() && !( value < maxDeque.Back().value ) )
+		{
+			maxDeque.PopBack();
+		}
+		maxDeque.PushBack( sample );
+	}
+
+	/**
+	* @brief Adds a chunk of samples to a count window
+	*
+	* @param values The samples, oldest first
+	*/
+	void PushChunk( std::span<const T> values )
+	{
+		for ( const T value : values )
+		{
+			Push( value );
+		}
+	}
+
+	/**
+	* @brief Adds a chunk of timed samples
+	*
+	* @param values The samples, oldest first
+	* @param times When each sample arrived, must be at least values.size()
+	*/
+	void PushChunk( std::span<const T> values, std::span<const Timestamp> times )
+	{
+		for ( std::size_t i = 0; i < values.size(); ++i )
+		{
+			Push( values[ i ], times[ i ] );
+		}
+	}
+
+	/**
+	* @brief Expires samples from a time window without adding one
+	*
+	* A sample is in the window while now - time < windowLength.
+	* Does nothing for a count window.
+	*
+	* @param now The current time
+	*/
+	void AdvanceTo( const Timestamp now )
+	{
+		if ( length == 0 )
+		{
+			return;
+		}
+
+		while ( !window.Empty() && now - window.Front().time >= length )
+		{
+			PopOldest();
+		}
+	}
+
+	/**
+	* @brief Drops every sample, the stream position keeps counting
+	*/
+	void Clear()
+	{
+		window.Clear();
+		minDeque.Clear();
+		maxDeque.Clear();
+		sum = 0;
+	}
+
+	/**
+	* @brief Gets the number of samples in the window
+	*
+	* @return Samples in the window
+	*/
+	std::size_t Count() const
+	{
+		return window.Size();
+	}
+
+	/**
+	* @brief Gets the sum of the window
+	*
+	* @return Sum, 0 for an empty window
+	*/
+	SumType Sum() const
+	{
+		return sum;
+	}
+
+	/**
+	* @brief Gets the smallest sample in the window
+	*
+	* @return std::nullopt for an empty window, else the min
+	*/
+	std::optional<T> Min() const
+	{
+		return minDeque.Empty() ? std::nullopt : std::optional<T>( minDeque.Front().value );
+	}
+
+	/**
+	* @brief Gets the largest sample in the window
+	*
+	* @return std::nullopt for an empty window, else the max
+	*/
+	std::optional<T> Max() const
+	{
+		return maxDeque.Empty() ? std::nullopt : std::optional<T>( maxDeque.Front().value );
+	}
+
+	/**
+	* @brief Gets the total number of samples pushed
+	*
+	* @return Samples seen since construction
+	*/
+	std::uint64_t SamplesSeen() const
+	{
+		return nextSequence;
+	}
+
+private:
+	/**
+	* @brief Removes the oldest sample from the window and the deques
+	*/
+	void PopOldest()
+	{
+		const Sample& oldest = window.Front();
+		sum -= static_cast< SumType >( oldest.value );
+
+		if ( !minDeque.Empty() && minDeque.Front().sequence == oldest.sequence )
+		{
+			minDeque.PopFront();
+		}
+		if ( !maxDeque.Empty() && maxDeque.Front().sequence == oldest.sequence )
+		{
+			maxDeque.PopFront();
+		}
+		window.PopFront();
+	}
+};
+
+
+#endif // !STREAMINGWINDOW_HPP
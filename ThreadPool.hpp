@@ -0,0 +1,320 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+
+#include <thread>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <algorithm>
+#include <utility>
+
+
+/**
+* @brief Reusable work stealing thread pool
+*
+* Every worker owns a queue. Tasks submitted from a worker go on
+* the back of its own queue and the worker pops from the back, so
+* recursive splits stay hot in that core's cache. When a worker runs
+* out of work it steals from the front of the other queues, which is
+* where the oldest and usually largest tasks are.
+*
+* Tasks submitted from outside the pool are spread round robin.
+*/
+class ThreadPool
+{
+private:
+	/**
+	* @brief A workers task queue, the mutex is only
+	* contended when someone is stealing
+	*/
+	struct WorkQueue
+	{
+		std::mutex lock; //< Guards tasks
+		std::deque<std::function<void()>> tasks; //< Owner uses the back, thieves the front
+	};
+
+	std::vector<std::unique_ptr<WorkQueue>> queues; //< One queue per worker
+	std::vector<std::thread> workers; //< Our worker threads
+	std::mutex sleepLock; //< Guards sleeping on sleepSignal
+	std::condition_variable sleepSignal; //< Wakes idle workers on new tasks
+	std::atomic<std::size_t> queuedTasks = 0; //< Tasks sitting in any queue
+	std::atomic<std::size_t> nextQueue = 0; //< Round robin index for outside submits
+	std::atomic<bool> stopping = false; //< Set when the pool is shutting down
+
+	static inline thread_local ThreadPool* workerPool = nullptr; //< Pool the current thread works for
+	static inline thread_local std::size_t workerIndex = 0; //< Queue index of the current worker
+
+public:
+	/**
+	* @brief Constructor, starts the workers
+	*
+	* @param threadCount Number of worker threads, minimum of 1
+	*/
+	explicit ThreadPool( const std::size_t threadCount = std::thread::hardware_concurrency() )
+	{
+		const std::size_t count = std::max< std::size_t >( threadCount, 1 );
+
+		queues.reserve( count );
+		for ( std::size_t i = 0; i < count; ++i )
+		{
+			queues.push_back( std::make_unique<WorkQueue>() );
+		}
+
+		workers.reserve( count );
+		for ( std::size_t i = 0; i < count; ++i )
+		{
+			workers.emplace_back( [ this, i ]() { WorkerLoop( i ); } );
+		}
+	}
+
+	/**
+	* @brief Destructor, finishes queued tasks then joins the workers
+	*/
+	~ThreadPool()
+	{
+		{
+			std::lock_guard lock( sleepLock );
+			stopping = true;
+		}
+		sleepSignal.notify_all();
+
+		for ( std::thread& worker : workers )
+		{
+			worker.join();
+		}
+	}
+
+	ThreadPool( const ThreadPool& ) = delete;
+	ThreadPool& operator=( const ThreadPool& ) = delete;
+
+	/**
+	* @brief Gets the number of worker threads
+	*
+	* @return Number of workers
+	*/
+	std::size_t GetThreadCount() const
+	{
+		return workers.size();
+	}
+
+	/**
+	* @brief Queues a task to be run by the pool
+	*
+	* @param task The task to run, this should not throw,
+	* use TaskGroup if you need exceptions passed back
+	*/
+	void Submit( std::function<void()> task )
+	{
+		const std::size_t index = workerPool == this ? workerIndex : nextQueue++ % queues.size();
+		{
+			std::lock_guard lock( queues[ index ]->lock );
+			queues[ index ]->tasks.push_back( std::move( task ) );
+		}
+		queuedTasks.fetch_add( 1 );
+
+		{
+			std::lock_guard lock( sleepLock );
+		}
+		sleepSignal.notify_one();
+	}
+
+	/**
+	* @brief Runs one queued task on the calling thread
+	*
+	* Workers take from their own queue first, then everyone
+	* steals from the other queues. This is what lets a thread
+	* that is waiting on a TaskGroup help out instead of blocking.
+	*
+	* @return true if a task was run, false if there was nothing to do
+	*/
+	bool RunPendingTask()
+	{
+		std::function<void()> task;
+		const bool isWorker = workerPool == this;
+
+		if ( ( isWorker && TryPopBack( workerIndex, task ) ) ||
+			 TrySteal( isWorker ? workerIndex + 1 : nextQueue.load(), task ) )
+		{
+			task();
+			return true;
+		}
+		return false;
+	}
+
+private:
+	/**
+	* @brief Pops the newest task from a queue
+	*
+	* @param index Index of the queue
+	* @param task Receives the task
+	* @return true if we got a task
+	*/
+	bool TryPopBack( const std::size_t index, std::function<void()>& task )
+	{
+		std::lock_guard lock( queues[ index ]->lock );
+		if ( queues[ index ]->tasks.empty() )
+		{
+			return false;
+		}
+
+		task = std::move( queues[ index ]->tasks.back() );
+		queues[ index ]->tasks.pop_back();
+		queuedTasks.fetch_sub( 1 );
+		return true;
+	}
+
+	/**
+	* @brief Steals the oldest task from any queue
+	*
+	* @param start Queue index to start looking at, so
+	* thieves don't all pile onto the same queue
+	* @param task Receives the task
+	* @return true if we got a task
+	*/
+	bool TrySteal( const std::size_t start, std::function<void()>& task )
+	{
+		for ( std::size_t i = 0; i < queues.size(); ++i )
+		{
+			WorkQueue& queue = *queues[ ( start + i ) % queues.size() ];
+
+			std::lock_guard lock( queue.lock );
+			if ( !queue.tasks.empty() )
+			{
+				task = std::move( queue.tasks.front() );
+				queue.tasks.pop_front();
+				queuedTasks.fetch_sub( 1 );
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	* @brief Main loop of each worker, runs tasks
+	* until the pool is stopped and empty
+	*
+	* @param index Index of this workers queue
+	*/
+	void WorkerLoop( const std::size_t index )
+	{
+		workerPool = this;
+		workerIndex = index;
+
+		while ( true )
+		{
+			if ( RunPendingTask() )
+			{
+				continue;
+			}
+
+			std::unique_lock lock( sleepLock );
+			sleepSignal.wait( lock, [ this ]() { return stopping || queuedTasks.load() > 0; } );
+			if ( stopping && queuedTasks.load() == 0 )
+			{
+				return;
+			}
+		}
+	}
+};
+
+
+/**
+* @brief Fork join helper on top of ThreadPool
+*
+* Run queues tasks on the pool, Wait runs queued tasks on the calling
+* thread until all of this group's tasks are done. Because waiting threads
+* keep working, groups can be nested ( recursive sorts ) without deadlocking.
+* The first exception thrown by a task is rethrown from Wait.
+*/
+class TaskGroup
+{
+private:
+	ThreadPool& pool; //< Pool the tasks run on
+	std::atomic<std::size_t> pending = 0; //< Tasks not finished yet
+	std::mutex errorLock; //< Guards error
+	std::exception_ptr error; //< First exception thrown by a task
+
+public:
+	/**
+	* @brief Constructor
+	*
+	* @param taskPool Pool to run the tasks on
+	*/
+	explicit TaskGroup( ThreadPool& taskPool ): pool( taskPool ) {}
+
+	/**
+	* @brief Destructor, waits for any tasks still running
+	* since they reference this group
+	*/
+	~TaskGroup()
+	{
+		WaitForTasks();
+	}
+
+	TaskGroup( const TaskGroup& ) = delete;
+	TaskGroup& operator=( const TaskGroup& ) = delete;
+
+	/**
+	* @brief Queues a task in this group
+	*
+	* @param task The task to run
+	*/
+	template< typename Task >
+	void Run( Task&& task )
+	{
+		pending.fetch_add( 1 );
+		pool.Submit( [ this, task = std::forward< Task >( task ) ]() mutable
+		{
+			try
+			{
+				task();
+			} catch ( ... )
+			{
+				std::lock_guard lock( errorLock );
+				if ( !error )
+				{
+					error = std::current_exception();
+				}
+			}
+			pending.fetch_sub( 1, std::memory_order_release );
+		} );
+	}
+
+	/**
+	* @brief Waits for every task in the group, helping the pool while we wait
+	*
+	* Rethrows the first exception a task threw
+	*/
+	void Wait()
+	{
+		WaitForTasks();
+		if ( error )
+		{
+			std::rethrow_exception( std::exchange( error, nullptr ) );
+		}
+	}
+
+private:
+	/**
+	* @brief Runs pool tasks until all our tasks are done
+	*/
+	void WaitForTasks()
+	{
+		while ( pending.load( std::memory_order_acquire ) > 0 )
+		{
+			if ( !pool.RunPendingTask() )
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+};
+
+
+#endif // !THREADPOOL_HPP
@@ -0,0 +1,460 @@
+#ifndef UNROLLEDLINKEDLIST_HPP
+#define UNROLLEDLINKEDLIST_HPP
+
+
+#include "ClassBase.hpp"
+#include "SortCores.hpp"
+#include <array>
+#include <span>
+#include <vector>
+#include <cstdint>
+
+
+/**
+* @brief One chunk of an unrolled linked list, up to
+* Entries entries stored side by side
+*
+* The entry numbers come first so a search by number only reads
+* a few cache lines of ints, the names follow them.
+*
+* @tparam T must be std::string or std::wstring
+* @tparam Entries Entries the chunk can hold
+*/
+template< typename T, std::size_t Entries >
+	requires StringType< T >
+struct alignas( 64 ) UnrolledChunk
+{
+	std::array< int, Entries > entryNums{}; //< Entry number of each entry
+	std::uint32_t count = 0; //< Entries in use, always the first count slots
+	UnrolledChunk* flink = nullptr; //< Forward link to the next chunk
+	UnrolledChunk* blink = nullptr; //< Backward link to the previous chunk
+	std::array< T, Entries > names; //< Name of each entry
+};
+
+
+/**
+* @brief Doubly linked list that packs its entries into
+* cache line aligned chunks instead of one node per entry
+*
+* Walking the list takes one pointer hop per chunk rather than per
+* entry, and the entries of a chunk are read front to back, so
+* searches and prints miss the cache a lot less. Chunks come from a
+* NodePool and are kept at least half full as entries are removed.
+*
+* It has the same operations as LinkedListAlgorithms and orders
+* names the same way, see CompareNames, so the two can be benchmarked
+* against each other, see LinkedListAlgorithms::BenchmarkLayouts.
+*
+* @tparam T must be std::string or std::wstring
+* @tparam ChunkEntries Entries per chunk, 8 to 64
+*/
+template< typename T, std::size_t ChunkEntries = 16 >
+	requires StringType< T >
+class UnrolledLinkedList
+{
+	static_assert( ChunkEntries >= 8 && ChunkEntries <= 64, "Chunks must hold 8 to 64 entries" );
+
+public:
+	using Chunk = UnrolledChunk< T, ChunkEntries >;
+
+	/**
+	* @brief Where an entry lives, the chunk is nullptr when there is no entry
+	*/
+	struct Position
+	{
+		Chunk* chunk = nullptr; //< Chunk holding the entry
+		std::uint32_t index = 0; //< Slot of the entry in the chunk
+	};
+
+private:
+	Chunk* first = nullptr; //< First chunk of the list
+	Chunk* last = nullptr; //< Last chunk, new entries go here
+	std::size_t numOfEntries = 0; //< Entries currently in the list
+	int lastEntryNum = 0; //< Entry number given to the last entry added
+	NodePool< Chunk, 256 > chunkPool; //< Every chunk of the list comes from here
+
+public:
+	UnrolledLinkedList() = default;
+
+	/**
+	* @brief Deconstructor, this calls RemoveAllEntries
+	* to clean up memory
+	*/
+	~UnrolledLinkedList()
+	{
+		RemoveAllEntries();
+	}
+
+	UnrolledLinkedList( const UnrolledLinkedList& ) = delete;
+	UnrolledLinkedList& operator=( const UnrolledLinkedList& ) = delete;
+
+	/// Entries currently in the list
+	std::size_t Size() const { return numOfEntries; }
+	/// Chunks currently in the list
+	std::size_t ChunkCount() const { return chunkPool.Size(); }
+
+
+	/**
+	* @brief Adds new entry to the end of the list
+	*
+	* Entry numbers count up from 1 like LinkListBase does
+	*
+	* @param name The name to add to the new entry
+	*/
+	void AddEntry( T name )
+	{
+		if ( last == nullptr || last->count == ChunkEntries )
+		{
+			Chunk* chunk = chunkPool.Allocate();
+			chunk->blink = last;
+			if ( last != nullptr )
+			{
+				last->flink = chunk;
+			} else
+			{
+				first = chunk;
+			}
+			last = chunk;
+		}
+
+		last->entryNums[ last->count ] = ++lastEntryNum;
+		last->names[ last->count ] = std::move( name );
+		++last->count;
+		++numOfEntries;
+	}
+
+
+	/**
+	* @brief Removes an entry from the list by name
+	*
+	* @param name The name to search for and remove
+	* @param binarySearch true if you want binary search, the list
+	* must be sorted by name, false, for linear search
+	* @return The name of the removed entry, or an empty name if not found
+	*/
+	T RemoveEntry( const T& name, const bool binarySearch )
+	{
+		const Position position = binarySearch ? BinarySearch( name ) : LinearSearch( name );
+		if ( position.chunk == nullptr )
+		{
+			return T();
+		}
+
+		T removed = std::move( position.chunk->names[ position.index ] );
+		Erase( position );
+		return removed;
+	}
+
+	/**
+	* @brief Removes an entry from the list by entry number
+	*
+	* @param entryNum The entry number to search for and remove
+	* @param binarySearch true if you want binary search, the list
+	* must be in entry number order, false, for linear search
+	* @return The entry number of the removed entry, or -100 if not found
+	*/
+	std::int32_t RemoveEntry( const int entryNum, const bool binarySearch )
+	{
+		const Position position = binarySearch ? BinarySearch( entryNum ) : LinearSearch( entryNum );
+		if ( position.chunk == nullptr )
+		{
+			return -100;
+		}
+
+		Erase( position );
+		return entryNum;
+	}
+
+
+	///---------------Linear-Search-------------------///
+
+	/**
+	* @brief Finds the first entry with a name, in list order
+	*
+	* @param name The name to search for
+	* @return Position of the entry, the chunk is nullptr if not found
+	*/
+	Position LinearSearch( const T& name ) const
+	{
+		return Scan( [ & ]( const Chunk* chunk, const std::uint32_t i ) { return CompareNames( name, chunk->names[ i ] ) == 0; } );
+	}
+
+	/**
+	* @brief Finds the entry with an entry number
+	*
+	* @param entryNum The entry number to search for
+	* @return Position of the entry, the chunk is nullptr if not found
+	*/
+	Position LinearSearch( const int entryNum ) const
+	{
+		return Scan( [ & ]( const Chunk* chunk, const std::uint32_t i ) { return chunk->entryNums[ i ] == entryNum; } );
+	}
+
+
+	///----------------Binary-Search------------------///
+
+	/**
+	* @brief Finds the first entry with a name in a list sorted by name
+	*
+	* Whole chunks are skipped by their last entry, then the
+	* chunk that can hold the name is binary searched
+	*
+	* @param name The name to search for
+	* @return Position of the entry, the chunk is nullptr if not found
+	*/
+	Position BinarySearch( const T& name ) const
+	{
+		return SortedSearch( [ & ]( const Chunk* chunk, const std::uint32_t i ) { return CompareNames( chunk->names[ i ], name ); } );
+	}
+
+	/**
+	* @brief Finds an entry number in a list that is in entry number order,
+	* see BinarySearch( name )
+	*
+	* @param entryNum The entry number to search for
+	* @return Position of the entry, the chunk is nullptr if not found
+	*/
+	Position BinarySearch( const int entryNum ) const
+	{
+		return SortedSearch( [ & ]( const Chunk* chunk, const std::uint32_t i )
+		{
+			return chunk->entryNums[ i ] < entryNum ? -1 : static_cast< int >( chunk->entryNums[ i ] > entryNum );
+		} );
+	}
+
+
+	///-----------------Sort-------------------////
+
+	/**
+	* @brief Sorts the list by name, equal names stay in entry number order
+	*
+	* The entries are moved out into one array, sorted there with
+	* SortCores::QuickSort and written back with every chunk full. Chunks
+	* left over once the list is packed go back to the pool.
+	*/
+	void SortEntries()
+	{
+		struct Entry
+		{
+			T name;
+			int entryNum;
+		};
+
+		std::vector< Entry > entries;
+		entries.reserve( numOfEntries );
+		for ( Chunk* chunk = first; chunk != nullptr; chunk = chunk->flink )
+		{
+			for ( std::uint32_t i = 0; i < chunk->count; ++i )
+			{
+				entries.push_back( { std::move( chunk->names[ i ] ), chunk->entryNums[ i ] } );
+			}
+		}
+
+		SortCores::QuickSort( std::span< Entry >( entries ), []( const Entry& a, const Entry& b )
+		{
+			const int compRes = CompareNames( a.name, b.name );
+			return compRes < 0 || ( compRes == 0 && a.entryNum < b.entryNum );
+		} );
+
+		// Refill from the front, there are always enough chunks
+		// As none of them held more than a full chunk
+		Chunk* chunk = first;
+		std::size_t next = 0;
+		while ( next < entries.size() )
+		{
+			const std::size_t count = std::min( ChunkEntries, entries.size() - next );
+			for ( std::size_t i = 0; i < count; ++i )
+			{
+				chunk->names[ i ] = std::move( entries[ next + i ].name );
+				chunk->entryNums[ i ] = entries[ next + i ].entryNum;
+			}
+			chunk->count = static_cast< std::uint32_t >( count );
+			next += count;
+			chunk = chunk->flink;
+		}
+
+		// Drop the chunks the packing freed up
+		while ( chunk != nullptr )
+		{
+			Chunk* nextChunk = chunk->flink;
+			Unlink( chunk );
+			chunk = nextChunk;
+		}
+	}
+
+
+	/**
+	* @brief Print the entry number and name
+	* of each entry in the list
+	*/
+	void PrintAllEntries() const
+	{
+		for ( const Chunk* chunk = first; chunk != nullptr; chunk = chunk->flink )
+		{
+			for ( std::uint32_t i = 0; i < chunk->count; ++i )
+			{
+				std::println( "==============" );
+				std::println( "Entry number: {}, Entry Name: {}",
+				chunk->entryNums[ i ], std::string( chunk->names[ i ].begin(), chunk->names[ i ].end() ) );
+				std::println( "==============" );
+			}
+		}
+	}
+
+
+	/**
+	* @brief Deletes all entries in the list
+	*
+	* Chunks go back to the pool a block at a time, so this
+	* only walks the chunks to run the names destructors
+	*/
+	void RemoveAllEntries()
+	{
+		if constexpr ( !std::is_trivially_destructible_v< Chunk > )
+		{
+			for ( Chunk* chunk = first; chunk != nullptr; )
+			{
+				Chunk* next = chunk->flink;
+				std::destroy_at( chunk );
+				chunk = next;
+			}
+		}
+
+		chunkPool.Release();
+		first = last = nullptr;
+		numOfEntries = 0;
+		lastEntryNum = 0;
+	}
+
+private:
+	/**
+	* @brief Walks the list in order until match is true
+	*
+	* The next chunk is prefetched while this one is scanned
+	*
+	* @param match Called with a chunk and a slot in it
+	* @return Position of the first match, the chunk is nullptr if not found
+	*/
+	template< typename Match >
+	Position Scan( Match match ) const
+	{
+		for ( Chunk* chunk = first; chunk != nullptr; chunk = chunk->flink )
+		{
+			Prefetch( chunk->flink );
+			for ( std::uint32_t i = 0; i < chunk->count; ++i )
+			{
+				if ( match( chunk, i ) )
+				{
+					return { chunk, i };
+				}
+			}
+		}
+		return {};
+	}
+
+	/**
+	* @brief Search shared by both BinarySearch overloads
+	*
+	* @param order Called with a chunk and a slot in it, negative if
+	* that entry comes before the key, 0 if it matches, else positive
+	* @return Position of the first match, the chunk is nullptr if not found
+	*/
+	template< typename Order >
+	Position SortedSearch( Order order ) const
+	{
+		for ( Chunk* chunk = first; chunk != nullptr; chunk = chunk->flink )
+		{
+			// The whole chunk comes before the key
+			if ( order( chunk, chunk->count - 1 ) < 0 )
+			{
+				continue;
+			}
+
+			// If the key is anywhere it is in this chunk
+			std::uint32_t low = 0;
+			std::uint32_t high = chunk->count - 1;
+			while ( low < high )
+			{
+				const std::uint32_t mid = low + ( high - low ) / 2;
+				if ( order( chunk, mid ) < 0 )
+				{
+					low = mid + 1;
+				} else
+				{
+					high = mid;
+				}
+			}
+
+			if ( order( chunk, low ) == 0 )
+			{
+				return { chunk, low };
+			}
+			return {};
+		}
+		return {};
+	}
+
+	/**
+	* @brief Removes the entry at position, the name must
+	* already have been moved out if it is wanted
+	*
+	* An empty chunk is unlinked. A chunk under half full takes
+	* in the next chunk when they fit in one
+	*
+	* @param position The entry to remove
+	*/
+	void Erase( const Position position )
+	{
+		Chunk* chunk = position.chunk;
+		for ( std::uint32_t i = position.index + 1; i < chunk->count; ++i )
+		{
+			chunk->names[ i - 1 ] = std::move( chunk->names[ i ] );
+			chunk->entryNums[ i - 1 ] = chunk->entryNums[ i ];
+		}
+		--chunk->count;
+		--numOfEntries;
+
+		if ( chunk->count == 0 )
+		{
+			Unlink( chunk );
+			return;
+		}
+
+		Chunk* next = chunk->flink;
+		if ( chunk->count < ChunkEntries / 2 && next != nullptr && chunk->count + next->count <= ChunkEntries )
+		{
+			std::move( next->names.begin(), next->names.begin() + next->count, chunk->names.begin() + chunk->count );
+			std::copy( next->entryNums.begin(), next->entryNums.begin() + next->count, chunk->entryNums.begin() + chunk->count );
+			chunk->count += next->count;
+			Unlink( next );
+		}
+	}
+
+	/**
+	* @brief Takes a chunk out of the list and gives it back to the pool
+	*
+	* @param chunk The chunk to remove
+	*/
+	void Unlink( Chunk* chunk )
+	{
+		if ( chunk->blink != nullptr )
+		{
+			chunk->blink->flink = chunk->flink;
+		} else
+		{
+			first = chunk->flink;
+		}
+
+		if ( chunk->flink != nullptr )
+		{
+			chunk->flink->blink = chunk->blink;
+		} else
+		{
+			last = chunk->blink;
+		}
+		chunkPool.Free( chunk );
+	}
+};
+
+
+#endif // !UNROLLEDLINKEDLIST_HPP
@@ -0,0 +1,441 @@
+#ifndef VECTORSEARCH_HPP
+#define VECTORSEARCH_HPP
+
+
+#include <cstddef>
+#include <cstdint>
+#include <bit>
+#include <vector>
+#include <span>
+#include <type_traits>
+#include <algorithm>
+
+#if defined( __AVX2__ ) || defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <immintrin.h>
+#endif
+
+
+/**
+* @brief Vectorized linear scans over unsorted arrays
+*
+* Each load compares a whole register of elements against the value, and
+* movemask squashes the compare down to one bit per byte or lane, so finding
+* the first hit is a count of trailing zeros. The main loops compare four
+* registers per iteration ( 32 ints with AVX2 ) and only look closer when
+* one of them hit.
+*
+* The kernel is picked at compile time by element type: every integer size
+* and float / double get AVX2 or SSE2 ( SSE4.1 for 64 bit integers ), any
+* type without a kernel and the tail of every array use a plain loop.
+*/
+namespace VectorSearch
+{
+    /// Registers compared per iteration of the main loops
+    inline constexpr std::size_t UNROLL = 4;
+
+    /**
+    * @brief Vector compare operations for T, zero lanes means no kernel
+    *
+    * MaskBits gives BITS_PER_LANE bits per element, all set on a match
+    */
+    template< typename T >
+    struct MatchOps
+    {
+        static constexpr std::size_t lanes = 0;
+    };
+
+#if defined( __AVX2__ )
+
+    /// 8 bit integers, 32 lanes
+    template< typename T >
+        requires ( std::is_integral_v<T> && sizeof( T ) == 1 )
+    struct MatchOps< T >
+    {
+        using Vec = __m256i;
+        static constexpr std::size_t lanes = 32;
+        static constexpr std::size_t BITS_PER_LANE = 1;
+
+        static Vec Broadcast( const T value ) { return _mm256_set1_epi8( static_cast< char >( value ) ); }
+        static Vec Load( const T* src ) { return _mm256_loadu_si256( reinterpret_cast< const __m256i* >( src ) ); }
+        static Vec Equal( const Vec a, const Vec b ) { return _mm256_cmpeq_epi8( a, b ); }
+        static Vec Or( const Vec a, const Vec b ) { return _mm256_or_si256( a, b ); }
+        static std::uint32_t MaskBits( const Vec v ) { return static_cast< std::uint32_t >( _mm256_movemask_epi8( v ) ); }
+    };
+
+    /// 16 bit integers, 16 lanes, there is no 16 bit movemask so we get 2 bits a lane
+    template< typename T >
+        requires ( std::is_integral_v<T> && sizeof( T ) == 2 )
+    struct MatchOps< T >
+    {
+        using Vec = __m256i;
+        static constexpr std::size_t lanes = 16;
+        static constexpr std::size_t BITS_PER_LANE = 2;
+
+        static Vec Broadcast( const T value ) { return _mm256_set1_epi16( static_cast< short >( value ) ); }
+        static Vec Load( const T* src ) { return _mm256_loadu_si256( reinterpret_cast< const __m256i* >( src ) ); }
+        static Vec Equal( const Vec a, const Vec b ) { return _mm256_cmpeq_epi16( a, b ); }
+        static Vec Or( const Vec a, const Vec b ) { return _mm256_or_si256( a, b ); }
+        static std::uint32_t MaskBits( const Vec v ) { return static_cast< std::uint32_t >( _mm256_movemask_epi8( v ) ); }
+    };
+
+    /// 32 bit integers, 8 lanes
+    template< typename T >
+        requires ( std::is_integral_v<T> && sizeof( T ) == 4 )
+    struct MatchOps< T >
+    {
+        using Vec = __m256i;
+        static constexpr std::size_t lanes = 8;
+        static constexpr std::size_t BITS_PER_LANE = 1;
+
+        static Vec Broadcast( const T value ) { return _mm256_set1_epi32( static_cast< int >( value ) ); }
+        static Vec Load( const T* src ) { return _mm256_loadu_si256( reinterpret_cast< const __m256i* >( src ) ); }
+        static Vec Equal( const Vec a, const Vec b ) { return _mm256_cmpeq_epi32( a, b ); }
+        static Vec Or( const Vec a, const Vec b ) { return _mm256_or_si256( a, b ); }
+        static std::uint32_t MaskBits( const Vec v ) { return static_cast< std::uint32_t >( _mm256_movemask_ps( _mm256_castsi256_ps( v ) ) ); }
+    };
+
+    /// 64 bit integers, 4 lanes
+    template< typename T >
+        requires ( std::is_integral_v<T> && sizeof( T ) == 8 )
+    struct MatchOps< T >
+    {
+        using Vec = __m256i;
+        static constexpr std::size_t lanes = 4;
+        static constexpr std::size_t BITS_PER_LANE = 1;
+
+        static Vec Broadcast( const T value ) { return _mm256_set1_epi64x( static_cast< long long >( value ) ); }
+        static Vec Load( const T* src ) { return _mm256_loadu_si256( reinterpret_cast< const __m256i* >( src ) ); }
+        static Vec Equal( const Vec a, const Vec b ) { return _mm256_cmpeq_epi64( a, b ); }
+        static Vec Or( const Vec a, const Vec b ) { return _mm256_or_si256( a, b ); }
+        static std::uint32_t MaskBits( const Vec v ) { return static_cast< std::uint32_t >( _mm256_movemask_pd( _mm256_castsi256_pd( v ) ) ); }
+    };
+
+    /// Floats, 8 lanes, ordered compare so NaN never matches, same as ==
+    template<>
+    struct MatchOps< float >
+    {
+        using Vec = __m256;
+        static constexpr std::size_t lanes = 8;
+        static constexpr std::size_t BITS_PER_LANE = 1;
+
+        static Vec Broadcast( const float value ) { return _mm256_set1_ps( value ); }
+        static Vec Load( const float* src ) { return _mm256_loadu_ps( src ); }
+        static Vec Equal( const Vec a, const Vec b ) { return _mm256_cmp_ps( a, b, _CMP_EQ_OQ ); }
+        static Vec Or( const Vec a, const Vec b ) { return _mm256_or_ps( a, b ); }
+        static std::uint32_t MaskBits( const Vec v ) { return static_cast< std::uint32_t >( _mm256_movemask_ps( v ) ); }
+    };
+
+    /// Doubles, 4 lanes
+    template<>
+    struct MatchOps< double >
+    {
+        using Vec = __m256d;
+        static constexpr std::size_t lanes = 4;
+        static constexpr std::size_t BITS_PER_LANE = 1;
+
+        static Vec Broadcast( const double value ) { return _mm256_set1_pd( value ); }
+        static Vec Load( const double* src ) { return _mm256_loadu_pd( src ); }
+        static Vec Equal( const Vec a, const Vec b ) { return _mm256_cmp_pd( a, b, _CMP_EQ_OQ ); }
+        static Vec Or( const Vec a, const Vec b ) { return _mm256_or_pd( a, b ); }
+        static std::uint32_t MaskBits( const Vec v ) { return static_cast< std::uint32_t >( _mm256_movemask_pd( v ) ); }
+    };
+
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+
+    /// 8 bit integers, 16 lanes
+    template< typename T >
+        requires ( std::is_integral_v<T> && sizeof( T ) == 1 )
+    struct MatchOps< T >
+    {
+        using Vec = __m128i;
+        static constexpr std::size_t lanes = 16;
+        static constexpr std::size_t BITS_PER_LANE = 1;
+
+        static Vec Broadcast( const T value ) { return _mm_set1_epi8( static_cast< char >( value ) ); }
+        static Vec Load( const T* src ) { return _mm_loadu_si128( reinterpret_cast< const __m128i* >( src ) ); }
+        static Vec Equal( const Vec a, const Vec b ) { return _mm_cmpeq_epi8( a, b ); }
+        static Vec Or( const Vec a, const Vec b ) { return _mm_or_si128( a, b ); }
+        static std::uint32_t MaskBits( const Vec v ) { return static_cast< std::uint32_t >( _mm_movemask_epi8( v ) ); }
+    };
+
+    /// 16 bit integers, 8 lanes, 2 bits a lane
+    template< typename T >
+        requires ( std::is_integral_v<T> && sizeof( T ) == 2 )
+    struct MatchOps< T >
+    {
+        using Vec = __m128i;
+        static constexpr std::size_t lanes = 8;
+        static constexpr std::size_t BITS_PER_LANE = 2;
+
+        static Vec Broadcast( const T value ) { return _mm_set1_epi16( static_cast< short >( value ) ); }
+        static Vec Load( const T* src ) { return _mm_loadu_si128( reinterpret_cast< const __m128i* >( src ) ); }
+        static Vec Equal( const Vec a, const Vec b ) { return _mm_cmpeq_epi16( a, b ); }
+        static Vec Or( const Vec a, const Vec b ) { return _mm_or_si128( a, b ); }
+        static std::uint32_t MaskBits( const Vec v ) { return static_cast< std::uint32_t >( _mm_movemask_epi8( v ) ); }
+    };
+
+    /// 32 bit integers, 4 lanes
+    template< typename T >
+        requires ( std::is_integral_v<T> && sizeof( T ) == 4 )
+    struct MatchOps< T >
+    {
+        using Vec = __m128i;
+        static constexpr std::size_t lanes = 4;
+        static constexpr std::size_t BITS_PER_LANE = 1;
+
+        static Vec Broadcast( const T value ) { return _mm_set1_epi32( static_cast< int >( value ) ); }
+        static Vec Load( const T* src ) { return _mm_loadu_si128( reinterpret_cast< const __m128i* >( src ) ); }
+        static Vec Equal( const Vec a, const Vec b ) { return _mm_cmpeq_epi32( a, b ); }
+        static Vec Or( const Vec a, const Vec b ) { return _mm_or_si128( a, b ); }
+        static std::uint32_t MaskBits( const Vec v ) { return static_cast< std::uint32_t >( _mm_movemask_ps( _mm_castsi128_ps( v ) ) ); }
+    };
+
+#if defined( __SSE4_1__ ) || defined( __AVX__ )
+    /// 64 bit integers, 2 lanes, the compare needs SSE4.1
+    template< typename T >
+        requires ( std::is_integral_v<T> && sizeof( T ) == 8 )
+    struct MatchOps< T >
+    {
+        using Vec = __m128i;
+        static constexpr std::size_t lanes = 2;
+        static constexpr std::size_t BITS_PER_LANE = 1;
+
+        static Vec Broadcast( const T value ) { return _mm_set1_epi64x( static_cast< long long >( value ) ); }
+        static Vec Load( const T* src ) { return _mm_loadu_si128( reinterpret_cast< const __m128i* >( src ) ); }
+        static Vec Equal( const Vec a, const Vec b ) { return _mm_cmpeq_epi64( a, b ); }
+        static Vec Or( const Vec a, const Vec b ) { return _mm_or_si128( a, b ); }
+        static std::uint32_t MaskBits( const Vec v ) { return static_cast< std::uint32_t >( _mm_movemask_pd( _mm_castsi128_pd( v ) ) ); }
+    };
+#endif
+
+    /// Floats, 4 lanes
+    template<>
+    struct MatchOps< float >
+    {
+        using Vec = __m128;
+        static constexpr std::size_t lanes = 4;
+        static constexpr std::size_t BITS_PER_LANE = 1;
+
+        static Vec Broadcast( const float value ) { return _mm_set1_ps( value ); }
+        static Vec Load( const float* src ) { return _mm_loadu_ps( src ); }
+        static Vec Equal( const Vec a, const Vec b ) { return _mm_cmpeq_ps( a, b ); }
+        static Vec Or( const Vec a, const Vec b ) { return _mm_or_ps( a, b ); }
+        static std::uint32_t MaskBits( const Vec v ) { return static_cast< std::uint32_t >( _mm_movemask_ps( v ) ); }
+    };
+
+    /// Doubles, 2 lanes
+    template<>
+    struct MatchOps< double >
+    {
+        using Vec = __m128d;
+        static constexpr std::size_t lanes = 2;
+        static constexpr std::size_t BITS_PER_LANE = 1;
+
+        static Vec Broadcast( const double value ) { return _mm_set1_pd( value ); }
+        static Vec Load( const double* src ) { return _mm_loadu_pd( src ); }
+        static Vec Equal( const Vec a, const Vec b ) { return _mm_cmpeq_pd( a, b ); }
+        static Vec Or( const Vec a, const Vec b ) { return _mm_or_pd( a, b ); }
+        static std::uint32_t MaskBits( const Vec v ) { return static_cast< std::uint32_t >( _mm_movemask_pd( v ) ); }
+    };
+
+#endif
+
+    /// True when T has a vector kernel on this build
+    template< typename T >
+    inline constexpr bool hasSimdSearch = MatchOps< T >::lanes > 0;
+
+    /**
+    * @brief Gets the match bits of one register of elements
+    *
+    * @param data First element of the register
+    * @param needle The value broadcast to every lane
+    * @return BITS_PER_LANE bits per element, set where it matched
+    */
+    template< typename T >
+    inline std::uint32_t MatchBits( const T* data, const typename MatchOps< T >::Vec needle )
+    {
+        using Ops = MatchOps< T >;
+        return Ops::MaskBits( Ops::Equal( Ops::Load( data ), needle ) );
+    }
+
+    /**
+    * @brief Finds the first element equal to value
+    *
+    * @param data First element of the array
+    * @param size Number of elements
+    * @param value Value to search for
+    * @return Index of the first match, or SIZE_MAX if not found
+    */
+    template< typename T >
+    inline std::size_t FindFirst( const T* data, const std::size_t size, const T value )
+    {
+        std::size_t i = 0;
+
+        if constexpr ( hasSimdSearch< T > )
+        {
+            using Ops = MatchOps< T >;
+            constexpr std::size_t step = Ops::lanes * UNROLL;
+            const auto needle = Ops::Broadcast( value );
+
+            for ( ; i + step <= size; i += step )
+            {
+                const auto hit0 = Ops::Equal( Ops::Load( data + i ), needle );
+                const auto hit1 = Ops::Equal( Ops::Load( data + i + Ops::lanes ), needle );
+                const auto hit2 = Ops::Equal( Ops::Load( data + i + Ops::lanes * 2 ), needle );
+                const auto hit3 = Ops::Equal( Ops::Load( data + i + Ops::lanes * 3 ), needle );
+
+                /// One test for all four registers, we only work out which one on a hit
+                if ( Ops::MaskBits( Ops::Or( Ops::Or( hit0, hit1 ), Ops::Or( hit2, hit3 ) ) ) != 0 )
+                {
+                    break;
+                }
+            }
+
+            for ( ; i + Ops::lanes <= size; i += Ops::lanes )
+            {
+                const std::uint32_t bits = MatchBits( data + i, needle );
+                if ( bits != 0 )
+                {
+                    return i + std::countr_zero( bits ) / Ops::BITS_PER_LANE;
+                }
+            }
+        }
+
+        for ( ; i < size; ++i )
+        {
+            if ( data[ i ] == value )
+            {
+                return i;
+            }
+        }
+        return SIZE_MAX;
+    }
+
+    /**
+    * @brief Counts the elements equal to value
+    *
+    * @param data First element of the array
+    * @param size Number of elements
+    * @param value Value to count
+    * @return Number of matches
+    */
+    template< typename T >
+    inline std::size_t Count( const T* data, const std::size_t size, const T value )
+    {
+        std::size_t i = 0;
+        std::size_t bitCount = 0;
+        std::size_t count = 0;
+
+        if constexpr ( hasSimdSearch< T > )
+        {
+            using Ops = MatchOps< T >;
+            /// Pack the masks of as many registers as fit into one word, so we pay for one popcount
+            constexpr std::size_t maskWidth = Ops::lanes * Ops::BITS_PER_LANE;
+            constexpr std::size_t perWord = std::min< std::size_t >( UNROLL, 64 / maskWidth );
+            const auto needle = Ops::Broadcast( value );
+
+            for ( ; i + Ops::lanes * perWord <= size; i += Ops::lanes * perWord )
+            {
+                std::uint64_t bits = 0;
+                for ( std::size_t r = 0; r < perWord; ++r )
+                {
+                    bits |= std::uint64_t( MatchBits( data + i + r * Ops::lanes, needle ) ) << ( r * maskWidth );
+                }
+                bitCount += std::popcount( bits );
+            }
+
+            for ( ; i + Ops::lanes <= size; i += Ops::lanes )
+            {
+                bitCount += std::popcount( MatchBits( data + i, needle ) );
+            }
+            count = bitCount / Ops::BITS_PER_LANE;
+        }
+
+        for ( ; i < size; ++i )
+        {
+            count += data[ i ] == value;
+        }
+        return count;
+    }
+
+    /**
+    * @brief Calls sink with the index of every element equal to value, in order
+    *
+    * @param data First element of the array
+    * @param size Number of elements
+    * @param value Value to search for
+    * @param sink Called with each matching index
+    */
+    template< typename T, typename Sink >
+    inline void ForEachMatch( const T* data, const std::size_t size, const T value, Sink&& sink )
+    {
+        std::size_t i = 0;
+
+        if constexpr ( hasSimdSearch< T > )
+        {
+            using Ops = MatchOps< T >;
+            constexpr std::uint32_t laneBits = ( 1u << Ops::BITS_PER_LANE ) - 1;
+            const auto needle = Ops::Broadcast( value );
+
+            for ( ; i + Ops::lanes <= size; i += Ops::lanes )
+            {
+                std::uint32_t bits = MatchBits( data + i, needle );
+                while ( bits != 0 )
+                {
+                    const std::size_t bit = std::countr_zero( bits );
+                    sink( i + bit / Ops::BITS_PER_LANE );
+                    bits &= ~( laneBits << bit );
+                }
+            }
+        }
+
+        for ( ; i < size; ++i )
+        {
+            if ( data[ i ] == value )
+            {
+                sink( i );
+            }
+        }
+    }
+
+    /**
+    * @brief Finds every element equal to value
+    *
+    * @param data First element of the array
+    * @param size Number of elements
+    * @param value Value to search for
+    * @param matches Indexes of the matches are appended here, in order
+    */
+    template< typename T >
+    inline void FindAll( const T* data, const std::size_t size, const T value, std::vector<std::size_t>& matches )
+    {
+        ForEachMatch( data, size, value, [ &matches ]( const std::size_t index ) { matches.push_back( index ); } );
+    }
+
+    /**
+    * @brief Finds every element equal to value, into a buffer the caller owns
+    *
+    * @param data First element of the array
+    * @param size Number of elements
+    * @param value Value to search for
+    * @param matches Receives the first matches.size() matching indexes, in order
+    * @return Total number of matches, more than matches.size() if some didn't fit
+    */
+    template< typename T >
+    inline std::size_t FindAll( const T* data, const std::size_t size, const T value, std::span<std::size_t> matches )
+    {
+        std::size_t count = 0;
+        ForEachMatch( data, size, value, [ &count, matches ]( const std::size_t index )
+        {
+            if ( count < matches.size() )
+            {
+                matches[ count ] = index;
+            }
+            ++count;
+        } );
+        return count;
+    }
+}
+
+
+#endif // !VECTORSEARCH_HPP